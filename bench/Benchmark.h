@@ -0,0 +1,50 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// Helpers shared by the benchmarks of bench/, each of them is its own executable.
+// Build them in Release, a Debug build measures the assertions and the missing inlining.
+namespace Benchmark
+{
+    // Distinct and well spread for distinct inputs, so key sets are reproducible without a random engine.
+    inline uint64_t splitmix64(uint64_t value) noexcept
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    // Keeps the compiler from dropping a computation whose result is otherwise unused.
+    template<typename T>
+    void keep(const T& value) noexcept
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile T sink;
+        sink = value;
+#endif
+    }
+
+    template<typename Function>
+    double seconds_of(Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // argv[index] as a count, or `fallback` when it is missing.
+    inline size_t argument_or(const int argc, char** argv, const int index, const size_t fallback)
+    {
+        return argc > index ? static_cast<size_t>(std::strtoull(argv[index], nullptr, 10)) : fallback;
+    }
+}
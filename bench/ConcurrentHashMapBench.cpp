@@ -0,0 +1,142 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ConcurrentHashMap.h"
+#include "HashMap.h"
+
+// Throughput of ConcurrentHashMap against a ClosedHashMap behind one global mutex, from 1 to 64 threads, on a
+// read-heavy (95% find, 5% insert_or_assign) and a write-heavy (50/50) mix of uniformly random keys. The total
+// operation count is the same for every thread count, so a flat line means no scaling at all. Scaling can only
+// show on a machine with at least as many cores as threads.
+// Usage: ConcurrentHashMapBench [maximum thread count, 64 by default] [operations per run, 4194304 by default]
+namespace
+{
+    using Key = uint64_t;
+
+    constexpr size_t key_count = 1ull << 20;
+
+    struct Mix
+    {
+        const char* name;
+        uint64_t read_percent;
+    };
+
+    constexpr Mix mixes[] = {{"95/5", 95ull}, {"50/50", 50ull}};
+
+    // The single lock the sharded map is meant to replace.
+    class GlobalLockMap
+    {
+        std::mutex mutex;
+        ClosedHashMap::HashMap<Key, uint64_t, std::hash<Key>, std::equal_to<Key>, HashMapPolicy::PowerOfTwoIndexing> map;
+
+    public:
+        bool contains(const Key key)
+        {
+            std::lock_guard lock(mutex);
+            return map.try_find(key) != nullptr;
+        }
+
+        void insert_or_assign(const Key key, const uint64_t value)
+        {
+            std::lock_guard lock(mutex);
+            map.insert(key, value);
+        }
+    };
+
+    // Runs `operation_count` operations split over `thread_count` threads that start together, returns the seconds.
+    template<typename Map>
+    double run_mix(Map& map, const size_t thread_count, const size_t operation_count, const uint64_t read_percent)
+    {
+        std::atomic<bool> start = false;
+        std::vector<std::thread> threads;
+        const size_t per_thread = operation_count / thread_count;
+
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                while (!start.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+                size_t hits = 0ull;
+                uint64_t state = Benchmark::splitmix64(t + 1);
+                for (size_t i = 0; i < per_thread; ++i)
+                {
+                    state = Benchmark::splitmix64(state);
+                    const Key key = state % key_count;
+                    if ((state >> 32) % 100ull < read_percent)
+                    {
+                        hits += map.contains(key);
+                    }
+                    else
+                    {
+                        map.insert_or_assign(key, state);
+                    }
+                }
+                Benchmark::keep(hits);
+            });
+        }
+
+        return Benchmark::seconds_of([&]
+        {
+            start.store(true, std::memory_order_release);
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        });
+    }
+
+    // Half of the key space is present before the run.
+    template<typename Map>
+    void prefill(Map& map)
+    {
+        for (Key key = 0; key < key_count; key += 2)
+        {
+            map.insert_or_assign(key, key);
+        }
+    }
+
+    void print(const size_t thread_count, const char* mix, const char* name, const size_t operation_count, const double seconds)
+    {
+        std::cout << std::setw(8) << thread_count << std::setw(8) << mix << std::setw(20) << name
+                  << std::setw(12) << std::setprecision(2) << static_cast<double>(operation_count) / seconds / 1e6 << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t maximum_threads = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 1, 64ull));
+    const size_t operation_count = Benchmark::argument_or(argc, argv, 2, 1ull << 22);
+
+    std::cout << std::fixed << std::thread::hardware_concurrency() << " hardware threads\n"
+              << std::setw(8) << "threads" << std::setw(8) << "mix" << std::setw(20) << "map" << std::setw(12) << "M ops/s" << "\n";
+
+    for (size_t thread_count = 1; thread_count <= maximum_threads; thread_count *= 2)
+    {
+        for (const Mix& mix : mixes)
+        {
+            ConcurrentHashMap<Key, uint64_t> sharded;
+            prefill(sharded);
+            print(thread_count, mix.name, "ConcurrentHashMap", operation_count, run_mix(sharded, thread_count, operation_count, mix.read_percent));
+
+            GlobalLockMap global;
+            prefill(global);
+            print(thread_count, mix.name, "global mutex", operation_count, run_mix(global, thread_count, operation_count, mix.read_percent));
+        }
+    }
+    return 0;
+}
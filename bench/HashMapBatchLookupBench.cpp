@@ -0,0 +1,108 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Benchmark.h"
+#include "HashMap.h"
+
+// Lookups per second of find_batch against one find per key, on tables much larger than the last level cache
+// so that nearly every lookup misses it. Keys are looked up in random order, and both loops add up the values
+// found so the batch version pays for reading its results too.
+// Usage: HashMapBatchLookupBench [element count, 4194304 by default] [keys per find_batch call, 256 by default]
+namespace
+{
+    using Key = uint64_t;
+    using Closed = ClosedHashMap::HashMap<Key, uint64_t, std::hash<Key>, std::equal_to<Key>, HashMapPolicy::PowerOfTwoIndexing>;
+    using Open = OpenHashMap::HashMap<Key, uint64_t, std::hash<Key>, std::equal_to<Key>, HashMapPolicy::PowerOfTwoIndexing>;
+
+    uint64_t find_one(Closed& map, const Key key)
+    {
+        return *map.try_find(key);
+    }
+
+    uint64_t find_one(Open& map, const Key key)
+    {
+        return map.find(key);
+    }
+
+    void print(const char* name, const char* mode, const size_t lookups, const double seconds)
+    {
+        std::cout << std::setw(16) << name << std::setw(10) << mode
+                  << std::setw(14) << std::setprecision(1) << static_cast<double>(lookups) / seconds / 1e6 << "\n";
+    }
+
+    template<typename Map>
+    void measure(const char* name, const std::vector<Key>& keys, const std::vector<Key>& lookups, const size_t batch_size)
+    {
+        // ClosedHashMap has no reserve(), linear hashing splits one bucket per insertion anyway.
+        Map map;
+        if constexpr (requires { map.reserve(keys.size()); })
+        {
+            map.reserve(keys.size());
+        }
+        std::vector<uint64_t> values(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            values[i] = i;
+        }
+        map.insert_batch(std::span<const Key>(keys), std::span<const uint64_t>(values));
+
+        uint64_t checksum = 0ull;
+        const double single_seconds = Benchmark::seconds_of([&]
+        {
+            for (const Key key : lookups)
+            {
+                checksum += find_one(map, key);
+            }
+        });
+
+        std::vector<uint64_t*> out(batch_size);
+        const double batch_seconds = Benchmark::seconds_of([&]
+        {
+            for (size_t first = 0; first < lookups.size(); first += batch_size)
+            {
+                const size_t count = std::min(batch_size, lookups.size() - first);
+                map.find_batch(std::span<const Key>(lookups).subspan(first, count), std::span<uint64_t*>(out).first(count));
+                for (size_t i = 0; i < count; ++i)
+                {
+                    checksum += *out[i];
+                }
+            }
+        });
+
+        Benchmark::keep(checksum);
+        print(name, "find", lookups.size(), single_seconds);
+        print(name, "batch", lookups.size(), batch_seconds);
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t element_count = Benchmark::argument_or(argc, argv, 1, 1ull << 22);
+    const size_t batch_size = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 2, 256ull));
+
+    std::mt19937_64 random(23);
+    std::vector<Key> keys(element_count);
+    for (size_t i = 0; i < element_count; ++i)
+    {
+        keys[i] = Benchmark::splitmix64(i);
+    }
+
+    std::vector<Key> lookups(keys);
+    std::shuffle(lookups.begin(), lookups.end(), random);
+
+    std::cout << std::fixed << element_count << " elements, " << batch_size << " keys per batch\n"
+              << std::setw(16) << "map" << std::setw(10) << "lookup" << std::setw(14) << "M lookups/s" << "\n";
+    measure<Closed>("ClosedHashMap", keys, lookups, batch_size);
+    measure<Open>("OpenHashMap", keys, lookups, batch_size);
+    return 0;
+}
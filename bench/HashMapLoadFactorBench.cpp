@@ -0,0 +1,169 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "HashMap.h"
+
+// Hit and miss lookups at load factors from 0.5 to 0.875: the Swiss table against OpenHashMap, whose cells
+// hold the whole pair next to its state, and std::unordered_map. Every map is filled to the same element
+// count and the open addressing ones are sized to the same capacity, so only the probing differs.
+// Usage: HashMapLoadFactorBench [log2 of the capacity, 20 by default]
+namespace
+{
+    using Key = uint64_t;
+    using Swiss = SwissHashMap::HashMap<Key, uint64_t>;
+    using Open = OpenHashMap::HashMap<Key, uint64_t, std::hash<Key>, std::equal_to<Key>, HashMapPolicy::PowerOfTwoIndexing>;
+    using Std = std::unordered_map<Key, uint64_t>;
+
+    constexpr float load_factors[] = {0.5f, 0.625f, 0.75f, 0.875f};
+    constexpr size_t minimum_lookups = 1ull << 23;
+
+    struct Result
+    {
+        double hit_ns = 0.0;
+        double miss_ns = 0.0;
+        size_t capacity = 0ull;
+    };
+
+    // Inserted keys have their low bit cleared and missing ones have it set, so a miss never hits by chance.
+    std::vector<Key> make_keys(const size_t count, const Key low_bit, std::mt19937_64& random)
+    {
+        std::vector<Key> keys(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            keys[i] = (Benchmark::splitmix64(i) & ~Key(1)) | low_bit;
+        }
+        std::shuffle(keys.begin(), keys.end(), random);
+        return keys;
+    }
+
+    template<typename Map>
+    void prepare(Map& map, const size_t count)
+    {
+        map.reserve(count);
+    }
+
+    void prepare(Open& map, const size_t count)
+    {
+        map.set_max_load_factor(0.9f);
+        map.reserve(count);
+    }
+
+    template<typename Map>
+    void insert(Map& map, const Key key, const uint64_t value)
+    {
+        map.insert(key, value);
+    }
+
+    void insert(Std& map, const Key key, const uint64_t value)
+    {
+        map.emplace(key, value);
+    }
+
+    template<typename Map>
+    uint64_t lookup(Map& map, const Key key)
+    {
+        return map.find(key);
+    }
+
+    uint64_t lookup(Std& map, const Key key)
+    {
+        return map.find(key)->second;
+    }
+
+    template<typename Map>
+    size_t capacity_of(const Map& map)
+    {
+        return map.get_capacity();
+    }
+
+    size_t capacity_of(const Std& map)
+    {
+        return map.bucket_count();
+    }
+
+    template<typename Map>
+    Result measure(const std::vector<Key>& present, const std::vector<Key>& missing)
+    {
+        Map map;
+        prepare(map, present.size());
+        for (size_t i = 0; i < present.size(); ++i)
+        {
+            insert(map, present[i], i);
+        }
+
+        const size_t rounds = std::max<size_t>(1ull, minimum_lookups / present.size());
+        Result result;
+        result.capacity = capacity_of(map);
+
+        uint64_t checksum = 0ull;
+        result.hit_ns = Benchmark::seconds_of([&]
+        {
+            for (size_t round = 0; round < rounds; ++round)
+            {
+                for (const Key key : present)
+                {
+                    checksum += lookup(map, key);
+                }
+            }
+        }) * 1e9 / static_cast<double>(rounds * present.size());
+
+        size_t found = 0ull;
+        result.miss_ns = Benchmark::seconds_of([&]
+        {
+            for (size_t round = 0; round < rounds; ++round)
+            {
+                for (const Key key : missing)
+                {
+                    found += map.contains(key);
+                }
+            }
+        }) * 1e9 / static_cast<double>(rounds * missing.size());
+
+        Benchmark::keep(checksum);
+        Benchmark::keep(found);
+        return result;
+    }
+
+    void print(const char* name, const size_t count, const Result& result)
+    {
+        std::cout << std::setw(16) << name
+                  << std::setw(12) << result.capacity
+                  << std::setw(10) << std::setprecision(3) << static_cast<double>(count) / static_cast<double>(result.capacity)
+                  << std::setw(12) << std::setprecision(1) << result.hit_ns
+                  << std::setw(12) << result.miss_ns << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t capacity = 1ull << Benchmark::argument_or(argc, argv, 1, 20ull);
+    std::mt19937_64 random(20);
+
+    std::cout << std::fixed << std::setw(16) << "map" << std::setw(12) << "capacity" << std::setw(10) << "load"
+              << std::setw(12) << "hit ns" << std::setw(12) << "miss ns" << "\n";
+
+    for (const float load_factor : load_factors)
+    {
+        const size_t count = static_cast<size_t>(load_factor * static_cast<float>(capacity));
+        const auto present = make_keys(count, 0ull, random);
+        const auto missing = make_keys(count, 1ull, random);
+
+        print("SwissHashMap", count, measure<Swiss>(present, missing));
+        print("OpenHashMap", count, measure<Open>(present, missing));
+        print("unordered_map", count, measure<Std>(present, missing));
+        std::cout << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "List.h"
+#include "MPSCQueue.h"
+
+// Messages per second from 1, 4, 16 and 64 producers to one consumer draining in batches, for MPSCQueue,
+// IntrusiveMPSCQueue and the List behind one mutex they are meant to replace. The total message count is the
+// same for every producer count, and the run ends when the consumer has received every message.
+// Usage: MPSCQueueBench [messages per run, 4194304 by default]
+namespace
+{
+    constexpr size_t producer_counts[] = {1ull, 4ull, 16ull, 64ull};
+
+    struct Message : MPSCQueueHook<>
+    {
+        uint64_t value = 0ull;
+    };
+
+    // The handoff the queues replace: producers append under the lock, the consumer swaps the whole list out.
+    class LockedList
+    {
+        std::mutex mutex;
+        List<uint64_t> pending;
+        List<uint64_t> batch;
+
+    public:
+        void push(const uint64_t value)
+        {
+            std::lock_guard lock(mutex);
+            pending.push_back(value);
+        }
+
+        template<typename Function>
+        size_t drain(Function&& function)
+        {
+            {
+                std::lock_guard lock(mutex);
+                swap(pending, batch);
+            }
+
+            const size_t count = batch.get_size();
+            for (const uint64_t value : batch)
+            {
+                function(value);
+            }
+            batch.reset();
+            return count;
+        }
+    };
+
+    // Starts `producer_count` producers together, each pushing its share of `message_count` through `produce`,
+    // and drains until every message is received. Returns the seconds from the start to the last message.
+    template<typename Produce, typename Drain>
+    double run(const size_t producer_count, const size_t message_count, Produce produce, Drain drain)
+    {
+        std::atomic<bool> start = false;
+        std::vector<std::thread> producers;
+        const size_t per_producer = message_count / producer_count;
+
+        for (size_t p = 0; p < producer_count; ++p)
+        {
+            producers.emplace_back([&, p]
+            {
+                while (!start.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                for (size_t i = p * per_producer; i < (p + 1) * per_producer; ++i)
+                {
+                    produce(i);
+                }
+            });
+        }
+
+        uint64_t checksum = 0ull;
+        const double seconds = Benchmark::seconds_of([&]
+        {
+            start.store(true, std::memory_order_release);
+            size_t received = 0ull;
+            while (received < per_producer * producer_count)
+            {
+                received += drain(checksum);
+            }
+        });
+
+        for (auto& thread : producers)
+        {
+            thread.join();
+        }
+        Benchmark::keep(checksum);
+        return seconds;
+    }
+
+    void print(const size_t producer_count, const char* name, const size_t message_count, const double seconds)
+    {
+        std::cout << std::setw(10) << producer_count << std::setw(22) << name
+                  << std::setw(12) << std::setprecision(2) << static_cast<double>(message_count) / seconds / 1e6 << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t message_count = Benchmark::argument_or(argc, argv, 1, 1ull << 22);
+
+    std::cout << std::fixed << std::thread::hardware_concurrency() << " hardware threads, " << message_count << " messages\n"
+              << std::setw(10) << "producers" << std::setw(22) << "queue" << std::setw(12) << "M msgs/s" << "\n";
+
+    // Intrusive messages are preallocated, they are only linked and unlinked during the run.
+    std::vector<Message> messages(message_count);
+
+    for (const size_t producer_count : producer_counts)
+    {
+        MPSCQueue<uint64_t> queue;
+        print(producer_count, "MPSCQueue", message_count, run(producer_count, message_count,
+            [&](const size_t i) { queue.push(static_cast<uint64_t>(i)); },
+            [&](uint64_t& checksum) { return queue.drain([&](const uint64_t value) { checksum += value; }); }));
+
+        IntrusiveMPSCQueue<Message> intrusive_queue;
+        print(producer_count, "IntrusiveMPSCQueue", message_count, run(producer_count, message_count,
+            [&](const size_t i)
+            {
+                messages[i].value = i;
+                intrusive_queue.push(messages[i]);
+            },
+            [&](uint64_t& checksum) { return intrusive_queue.drain([&](const Message& message) { checksum += message.value; }); }));
+
+        LockedList locked_list;
+        print(producer_count, "List + mutex", message_count, run(producer_count, message_count,
+            [&](const size_t i) { locked_list.push(static_cast<uint64_t>(i)); },
+            [&](uint64_t& checksum) { return locked_list.drain([&](const uint64_t value) { checksum += value; }); }));
+    }
+    return 0;
+}
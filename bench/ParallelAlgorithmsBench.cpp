@@ -0,0 +1,95 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "Benchmark.h"
+#include "ParallelAlgorithms.h"
+#include "ThreadPool.h"
+#include "Vector.h"
+
+// Scaling of parallel_for_each, parallel_reduce and parallel_sort from 1 thread up to the hardware concurrency,
+// doubling each time. Every run uses its own ThreadPool, whose workers plus the calling thread make the thread count,
+// and prints the time and the speedup over the single-threaded run. for_each and reduce are memory bound on a vector
+// larger than the last level cache, so they stop scaling once the memory bandwidth is saturated.
+// Usage: ParallelAlgorithmsBench [maximum thread count, hardware concurrency by default] [element count, 8388608 by default]
+namespace
+{
+    struct Timings
+    {
+        double for_each = 0.0;
+        double reduce = 0.0;
+        double sort = 0.0;
+    };
+
+    Timings run(const Vector<double>& unsorted, const size_t thread_count)
+    {
+        ThreadPool pool(std::max<size_t>(1ull, thread_count - 1));
+        const Parallel::Options options{.max_threads = thread_count, .pool = &pool};
+
+        Timings timings;
+        Vector<double> values(unsorted);
+        timings.for_each = Benchmark::seconds_of([&]
+        {
+            Parallel::parallel_for_each(values, [](double& value) { value = value * 1.0001 + 1.0; }, options);
+        });
+
+        double sum = 0.0;
+        timings.reduce = Benchmark::seconds_of([&]
+        {
+            sum = Parallel::parallel_reduce(values, 0.0, std::plus<>(), options);
+        });
+        Benchmark::keep(sum);
+
+        values = unsorted;
+        timings.sort = Benchmark::seconds_of([&]
+        {
+            Parallel::parallel_sort(values, std::less<>(), options);
+        });
+        return timings;
+    }
+
+    void print(const size_t thread_count, const char* algorithm, const double seconds, const double single_thread_seconds)
+    {
+        std::cout << std::setw(8) << thread_count << std::setw(18) << algorithm
+                  << std::setw(12) << std::setprecision(2) << seconds * 1e3
+                  << std::setw(10) << single_thread_seconds / seconds << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t hardware_threads = std::max<size_t>(1ull, std::thread::hardware_concurrency());
+    const size_t maximum_threads = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 1, hardware_threads));
+    const size_t element_count = Benchmark::argument_or(argc, argv, 2, 1ull << 23);
+
+    Vector<double> unsorted;
+    unsorted.reserve(element_count);
+    for (size_t i = 0; i < element_count; ++i)
+    {
+        unsorted.push_back(static_cast<double>(Benchmark::splitmix64(i) >> 11));
+    }
+
+    std::cout << std::fixed << hardware_threads << " hardware threads, " << element_count << " elements\n"
+              << std::setw(8) << "threads" << std::setw(18) << "algorithm" << std::setw(12) << "ms" << std::setw(10) << "speedup" << "\n";
+
+    Timings single_thread;
+    for (size_t thread_count = 1; thread_count <= maximum_threads; thread_count *= 2)
+    {
+        const Timings timings = run(unsorted, thread_count);
+        if (thread_count == 1)
+        {
+            single_thread = timings;
+        }
+        print(thread_count, "parallel_for_each", timings.for_each, single_thread.for_each);
+        print(thread_count, "parallel_reduce", timings.reduce, single_thread.reduce);
+        print(thread_count, "parallel_sort", timings.sort, single_thread.sort);
+    }
+    return 0;
+}
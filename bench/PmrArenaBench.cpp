@@ -0,0 +1,90 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Colony.h"
+#include "Deque.h"
+#include "SmallVector.h"
+#include "Vector.h"
+
+// Requests per second of a request-scoped workload built on the default heap allocator, then on the pmr aliases
+// fed by a std::pmr::monotonic_buffer_resource. Each request fills a Vector, a SmallVector that spills, a Deque and
+// a Colony, then drops them all. With the arena every deallocation is a no-op and the whole request is released
+// at once when the resource goes away; its buffer is reused from one request to the next.
+// Usage: PmrArenaBench [request count, 100000 by default] [elements per container, 128 by default]
+namespace
+{
+    template<typename VectorType, typename SmallVectorType, typename DequeType, typename ColonyType, typename... Allocator>
+    uint64_t serve_request(const size_t element_count, const Allocator&... allocator)
+    {
+        VectorType vector(allocator...);
+        SmallVectorType small_vector(allocator...);
+        DequeType deque(allocator...);
+        ColonyType colony(allocator...);
+
+        uint64_t checksum = 0ull;
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            vector.push_back(i);
+            small_vector.push_back(i);
+            deque.push_back(i);
+            colony.insert_back(uint64_t(i));
+        }
+        for (const uint64_t value : vector)
+        {
+            checksum += value;
+        }
+        return checksum + small_vector.get_size() + deque.size() + colony.size();
+    }
+
+    void print(const char* name, const size_t request_count, const double seconds)
+    {
+        std::cout << std::setw(24) << name << std::setw(14) << std::setprecision(0) << static_cast<double>(request_count) / seconds
+                  << std::setw(14) << std::setprecision(2) << seconds / static_cast<double>(request_count) * 1e6 << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t request_count = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 1, 100000ull));
+    // The Deque holds DequeSize_ * ChunkSize_ elements and starts in the middle of its chunks.
+    const size_t element_count = std::min<size_t>(Benchmark::argument_or(argc, argv, 2, 128ull), 256ull);
+
+    std::cout << std::fixed << request_count << " requests, " << element_count << " elements per container\n"
+              << std::setw(24) << "allocator" << std::setw(14) << "requests/s" << std::setw(14) << "us/request" << "\n";
+
+    uint64_t checksum = 0ull;
+    const double heap_seconds = Benchmark::seconds_of([&]
+    {
+        for (size_t r = 0; r < request_count; ++r)
+        {
+            checksum += serve_request<Vector<uint64_t>, SmallVector<uint64_t, 16ull>, Deque<uint64_t>, Colony<uint64_t>>(element_count);
+        }
+    });
+    print("default heap", request_count, heap_seconds);
+
+    std::vector<std::byte> arena_buffer(1ull << 20);
+    const double arena_seconds = Benchmark::seconds_of([&]
+    {
+        for (size_t r = 0; r < request_count; ++r)
+        {
+            std::pmr::monotonic_buffer_resource arena(arena_buffer.data(), arena_buffer.size());
+            const std::pmr::polymorphic_allocator<uint64_t> allocator(&arena);
+            checksum += serve_request<pmr::Vector<uint64_t>, pmr::SmallVector<uint64_t, 16ull>, pmr::Deque<uint64_t>, pmr::Colony<uint64_t>>(element_count, allocator);
+        }
+    });
+    print("pmr monotonic arena", request_count, arena_seconds);
+
+    Benchmark::keep(checksum);
+    return 0;
+}
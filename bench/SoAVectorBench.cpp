@@ -0,0 +1,115 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "Benchmark.h"
+#include "SoAVector.h"
+#include "Vector.h"
+
+// Single-field and two-field passes over particles stored as an array of structs in a Vector, and as a
+// structure of arrays in a SoAVector. The AoS pass loads whole 32-byte particles to use 4 bytes of each,
+// the SoA pass only streams the fields it reads. The default count is much larger than the last level cache.
+// Usage: SoAVectorBench [particle count, 4194304 by default] [passes, 20 by default]
+namespace
+{
+    struct Particle
+    {
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+        float vx = 0.f;
+        float vy = 0.f;
+        float vz = 0.f;
+        float mass = 0.f;
+        uint32_t id = 0u;
+    };
+
+    using Particles = SoAVector<float, float, float, float, float, float, float, uint32_t>;
+
+    constexpr size_t x_field = 0ull;
+    constexpr size_t vx_field = 3ull;
+
+    void print(const char* layout, const char* pass, const size_t element_count, const double seconds)
+    {
+        std::cout << std::setw(10) << layout << std::setw(18) << pass
+                  << std::setw(14) << std::setprecision(1) << static_cast<double>(element_count) / seconds / 1e6 << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t particle_count = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 1, 1ull << 22));
+    const size_t pass_count = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 2, 20ull));
+
+    Vector<Particle> structs;
+    Particles arrays;
+    structs.reserve(particle_count);
+    arrays.reserve(particle_count);
+    for (size_t i = 0; i < particle_count; ++i)
+    {
+        const auto position = static_cast<float>(Benchmark::splitmix64(i) % 1024ull);
+        const auto velocity = static_cast<float>(Benchmark::splitmix64(i + particle_count) % 16ull);
+        structs.push_back(Particle{position, position, position, velocity, velocity, velocity, 1.f, static_cast<uint32_t>(i)});
+        arrays.emplace_back(position, position, position, velocity, velocity, velocity, 1.f, static_cast<uint32_t>(i));
+    }
+
+    std::cout << std::fixed << particle_count << " particles, " << pass_count << " passes\n"
+              << std::setw(10) << "layout" << std::setw(18) << "pass" << std::setw(14) << "M elements/s" << "\n";
+
+    float sum = 0.f;
+    print("AoS", "sum x", particle_count * pass_count, Benchmark::seconds_of([&]
+    {
+        for (size_t pass = 0; pass < pass_count; ++pass)
+        {
+            for (const Particle& particle : structs)
+            {
+                sum += particle.x;
+            }
+        }
+    }));
+
+    print("SoA", "sum x", particle_count * pass_count, Benchmark::seconds_of([&]
+    {
+        for (size_t pass = 0; pass < pass_count; ++pass)
+        {
+            for (const float x : arrays.field<x_field>())
+            {
+                sum += x;
+            }
+        }
+    }));
+
+    print("AoS", "x += vx", particle_count * pass_count, Benchmark::seconds_of([&]
+    {
+        for (size_t pass = 0; pass < pass_count; ++pass)
+        {
+            for (Particle& particle : structs)
+            {
+                particle.x += particle.vx;
+            }
+        }
+    }));
+
+    print("SoA", "x += vx", particle_count * pass_count, Benchmark::seconds_of([&]
+    {
+        for (size_t pass = 0; pass < pass_count; ++pass)
+        {
+            const auto x = arrays.field<x_field>();
+            const auto vx = arrays.field<vx_field>();
+            for (size_t i = 0; i < x.size(); ++i)
+            {
+                x[i] += vx[i];
+            }
+        }
+    }));
+
+    Benchmark::keep(sum);
+    Benchmark::keep(structs[particle_count / 2].x + arrays.field<x_field>()[particle_count / 2]);
+    return 0;
+}
@@ -0,0 +1,111 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "Benchmark.h"
+#include "List.h"
+#include "UnrolledList.h"
+#include "Vector.h"
+
+// Traversal and mid-list insertion of UnrolledList against List and Vector, from 10^4 to 10^7 elements.
+// Traversal sums every element, insertion puts a batch of elements after the middle one, reached beforehand
+// through the cursor (or the index for Vector) so that only the insertions are timed.
+// List nodes are allocated in order here, a long-lived List whose nodes are scattered over the heap traverses slower.
+// Usage: UnrolledListBench [maximum element count, 10000000 by default] [insertions per run, 100 by default]
+namespace
+{
+    using Element = uint64_t;
+
+    template<typename Container>
+    Container filled(const size_t element_count)
+    {
+        Container container;
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            container.push_back(Benchmark::splitmix64(i));
+        }
+        return container;
+    }
+
+    template<typename Container>
+    double traversal_seconds(const Container& container)
+    {
+        Element sum = 0ull;
+        const double seconds = Benchmark::seconds_of([&]
+        {
+            for (const Element element : container)
+            {
+                sum += element;
+            }
+        });
+        Benchmark::keep(sum);
+        return seconds;
+    }
+
+    template<typename CursorList>
+    double insertion_seconds(CursorList& list, const size_t insert_count)
+    {
+        list.reset_cursor();
+        for (size_t i = list.get_size() / 2; i > 0ull; --i)
+        {
+            list.move_forward_cursor();
+        }
+
+        return Benchmark::seconds_of([&]
+        {
+            for (size_t i = 0; i < insert_count; ++i)
+            {
+                Benchmark::keep(list.insert_after_cursor(i));
+            }
+        });
+    }
+
+    double insertion_seconds(Vector<Element>& vector, const size_t insert_count)
+    {
+        const size_t middle = vector.get_size() / 2 + 1;
+        return Benchmark::seconds_of([&]
+        {
+            for (size_t i = 0; i < insert_count; ++i)
+            {
+                const Element element = i;
+                vector.insert(vector.begin() + middle, &element, &element + 1);
+            }
+        });
+    }
+
+    template<typename Container>
+    void measure(const char* name, const size_t element_count, const size_t insert_count)
+    {
+        Container container = filled<Container>(element_count);
+        const double traversal = traversal_seconds(container);
+        const double insertion = insertion_seconds(container, insert_count);
+
+        std::cout << std::setw(10) << element_count << std::setw(14) << name
+                  << std::setw(16) << std::setprecision(2) << traversal / static_cast<double>(element_count) * 1e9
+                  << std::setw(16) << insertion / static_cast<double>(insert_count) * 1e9 << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t maximum_count = Benchmark::argument_or(argc, argv, 1, 10000000ull);
+    const size_t insert_count = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 2, 100ull));
+
+    std::cout << std::fixed << insert_count << " insertions per run\n"
+              << std::setw(10) << "elements" << std::setw(14) << "container"
+              << std::setw(16) << "traversal ns/e" << std::setw(16) << "insert ns/e" << "\n";
+
+    for (size_t element_count = 10000ull; element_count <= maximum_count; element_count *= 10)
+    {
+        measure<UnrolledList<Element>>("UnrolledList", element_count, insert_count);
+        measure<List<Element>>("List", element_count, insert_count);
+        measure<Vector<Element>>("Vector", element_count, insert_count);
+    }
+    return 0;
+}
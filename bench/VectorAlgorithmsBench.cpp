@@ -0,0 +1,91 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "Benchmark.h"
+#include "Vector.h"
+#include "VectorAlgorithms.h"
+
+// Throughput in GB/s of every VectorAlgorithms kernel, for float, double and int32_t, under each instruction set
+// the CPU supports, forced through set_instruction_set. find looks for a missing value so that it scans the whole
+// vector, dot reads two vectors and fill writes one. The default length fits in the last level cache,
+// pass a larger one to measure memory bandwidth instead.
+// Usage: VectorAlgorithmsBench [element count, 262144 by default] [repetitions, 1000 by default]
+namespace
+{
+    using VectorAlgorithms::InstructionSet;
+
+    void print(const InstructionSet instruction_set, const char* type, const char* kernel, const size_t bytes, const double seconds)
+    {
+        std::cout << std::setw(8) << VectorAlgorithms::to_string(instruction_set) << std::setw(10) << type << std::setw(10) << kernel
+                  << std::setw(10) << std::setprecision(2) << static_cast<double>(bytes) / seconds / 1e9 << "\n";
+    }
+
+    // Times `repetitions` calls of `kernel`, each touching `bytes` bytes.
+    template<typename Kernel>
+    void measure(const InstructionSet instruction_set, const char* type, const char* kernel_name, const size_t bytes,
+                 const size_t repetitions, Kernel kernel)
+    {
+        const double seconds = Benchmark::seconds_of([&]
+        {
+            for (size_t i = 0; i < repetitions; ++i)
+            {
+                Benchmark::keep(kernel());
+            }
+        });
+        print(instruction_set, type, kernel_name, bytes * repetitions, seconds);
+    }
+
+    template<typename T>
+    void measure_kernels(const InstructionSet instruction_set, const char* type, const size_t length, const size_t repetitions)
+    {
+        Vector<T> first;
+        Vector<T> second;
+        for (size_t i = 0; i < length; ++i)
+        {
+            first.push_back(static_cast<T>(Benchmark::splitmix64(i) % 1000ull));
+            second.push_back(static_cast<T>(Benchmark::splitmix64(i + length) % 1000ull));
+        }
+
+        const size_t bytes = length * sizeof(T);
+        measure(instruction_set, type, "find", bytes, repetitions, [&] { return VectorAlgorithms::find(first, T(1000)); });
+        measure(instruction_set, type, "count", bytes, repetitions, [&] { return VectorAlgorithms::count(first, T(7)); });
+        measure(instruction_set, type, "minmax", bytes, repetitions, [&] { return VectorAlgorithms::minmax(first).second; });
+        measure(instruction_set, type, "sum", bytes, repetitions, [&] { return VectorAlgorithms::sum(first); });
+        measure(instruction_set, type, "dot", 2 * bytes, repetitions, [&] { return VectorAlgorithms::dot(first, second); });
+        measure(instruction_set, type, "fill", bytes, repetitions, [&]
+        {
+            VectorAlgorithms::fill(second, T(5));
+            return second[length / 2];
+        });
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t length = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 1, 1ull << 18));
+    const size_t repetitions = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 2, 1000ull));
+
+    const InstructionSet detected = VectorAlgorithms::detected_instruction_set();
+    std::cout << std::fixed << length << " elements, " << repetitions << " repetitions\n"
+              << std::setw(8) << "isa" << std::setw(10) << "type" << std::setw(10) << "kernel" << std::setw(10) << "GB/s" << "\n";
+
+    for (const auto instruction_set : {InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512})
+    {
+        if (static_cast<int>(instruction_set) > static_cast<int>(detected))
+            break;
+
+        VectorAlgorithms::set_instruction_set(instruction_set);
+        measure_kernels<float>(instruction_set, "float", length, repetitions);
+        measure_kernels<double>(instruction_set, "double", length, repetitions);
+        measure_kernels<int32_t>(instruction_set, "int32_t", length, repetitions);
+    }
+    VectorAlgorithms::set_instruction_set(detected);
+    return 0;
+}
@@ -0,0 +1,162 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+
+#include "Benchmark.h"
+#include "Relocate.h"
+#include "Vector.h"
+
+// Reallocation throughput of Vector::reserve on full vectors of 1M elements, comparing the single memcpy used for
+// trivially relocatable types with the element-wise move-and-destroy path. Each pair of types has the same layout and
+// only differs by its is_trivially_relocatable trait, so the difference is the relocation path alone.
+// Buffers are recycled by the allocator below, otherwise the page faults of fresh memory dominate both paths.
+// Usage: VectorReallocationBench [element count, 1000000 by default] [reallocations, 50 by default]
+namespace
+{
+    // Keeps freed buffers and hands them back to allocations of the same size, already touched.
+    // Never returns memory, which is fine for a benchmark doing the same few allocations over and over.
+    template<typename T>
+    struct RecyclingAllocator
+    {
+        using value_type = T;
+
+        RecyclingAllocator() = default;
+
+        template<typename U>
+        RecyclingAllocator(const RecyclingAllocator<U>&) noexcept
+        {
+        }
+
+        static std::multimap<size_t, void*>& free_buffers()
+        {
+            static std::multimap<size_t, void*> buffers;
+            return buffers;
+        }
+
+        T* allocate(const size_t count)
+        {
+            auto& buffers = free_buffers();
+            if (const auto it = buffers.find(count * sizeof(T)); it != buffers.end())
+            {
+                void* buffer = it->second;
+                buffers.erase(it);
+                return static_cast<T*>(buffer);
+            }
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate(T* buffer, const size_t count) noexcept
+        {
+            free_buffers().emplace(count * sizeof(T), buffer);
+        }
+
+        template<typename U>
+        bool operator==(const RecyclingAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+    };
+
+    struct Particle
+    {
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        uint64_t id = 0ull;
+    };
+
+    // Trivially copyable like Particle, opted out so that it takes the move-and-destroy path.
+    struct ParticleMovedOneByOne : Particle
+    {
+    };
+
+    // Not trivially copyable because of its unique_ptr, so it is moved one by one by default.
+    struct Handle
+    {
+        std::unique_ptr<uint64_t> value;
+    };
+
+    // A unique_ptr holds no pointer to itself, so a byte copy relocates it: opted in.
+    struct RelocatableHandle : Handle
+    {
+    };
+}
+
+template<>
+struct is_trivially_relocatable<ParticleMovedOneByOne> : std::false_type
+{
+};
+
+template<>
+struct is_trivially_relocatable<RelocatableHandle> : std::true_type
+{
+};
+
+namespace
+{
+    template<typename T>
+    T make_element(const size_t i)
+    {
+        T element;
+        if constexpr (std::is_base_of_v<Handle, T>)
+        {
+            element.value = std::make_unique<uint64_t>(i);
+        }
+        else
+        {
+            element.x = static_cast<double>(i);
+            element.id = i;
+        }
+        return element;
+    }
+
+    // Each reallocation starts from a vector whose capacity equals its size and doubles the capacity.
+    template<typename T>
+    void measure(const char* name, const size_t element_count, const size_t reallocation_count)
+    {
+        Vector<T, RecyclingAllocator<T>> vector;
+        vector.reserve(element_count);
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            vector.push_back(make_element<T>(i));
+        }
+
+        // Warms the recycled buffers up.
+        vector.reserve(element_count * 2);
+
+        double seconds = 0.0;
+        for (size_t i = 0; i < reallocation_count; ++i)
+        {
+            vector.shrink_to_fit();
+            seconds += Benchmark::seconds_of([&] { vector.reserve(element_count * 2); });
+        }
+        Benchmark::keep(vector[element_count / 2]);
+
+        const double bytes = static_cast<double>(element_count * sizeof(T) * reallocation_count);
+        std::cout << std::setw(24) << name << std::setw(12) << (is_trivially_relocatable_v<T> ? "memcpy" : "move")
+                  << std::setw(12) << std::setprecision(3) << seconds / static_cast<double>(reallocation_count) * 1e3
+                  << std::setw(10) << std::setprecision(2) << bytes / seconds / 1e9 << "\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const size_t element_count = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 1, 1000000ull));
+    const size_t reallocation_count = std::max<size_t>(1ull, Benchmark::argument_or(argc, argv, 2, 50ull));
+
+    std::cout << std::fixed << element_count << " elements, " << reallocation_count << " reallocations\n"
+              << std::setw(24) << "element" << std::setw(12) << "path" << std::setw(12) << "ms" << std::setw(10) << "GB/s" << "\n";
+    measure<Particle>("Particle", element_count, reallocation_count);
+    measure<ParticleMovedOneByOne>("Particle, opted out", element_count, reallocation_count);
+    measure<RelocatableHandle>("unique_ptr, opted in", element_count, reallocation_count);
+    measure<Handle>("unique_ptr", element_count, reallocation_count);
+    return 0;
+}
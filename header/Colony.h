@@ -6,16 +6,22 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <deque>
 #include <forward_list>
 #include <list>
+#include <memory>
+#include <memory_resource>
 #include <stack>
 #include <stdexcept>
 #include <utility>
 
 
-template<typename Ty_, size_t BlockSize_ = 16ull>
+template<typename Ty_, size_t BlockSize_ = 16ull, typename Allocator_ = std::allocator<Ty_>>
 class Colony
 {
+    template<typename U>
+    using RebindAllocator = typename std::allocator_traits<Allocator_>::template rebind_alloc<U>;
+
     enum class State
     {
         Empty,
@@ -96,9 +102,10 @@ class Colony
     class Block
     {
         using CellPair = std::pair<Cell, int>;
+        using CellStack = std::stack<CellPair*, std::deque<CellPair*, RebindAllocator<CellPair*>>>;
 
         std::array<CellPair, BlockSize> cell_array;
-        std::stack<CellPair*> free_list;
+        CellStack free_list;
         size_t real_size = 0ull;
 
         Block* next = nullptr;
@@ -127,7 +134,7 @@ class Colony
             }
         }
     public:
-        Block()
+        explicit Block(const Allocator_& allocator) : free_list(RebindAllocator<CellPair*>(allocator))
         {
             for (int i = BlockSize - 1; i > -1; --i)
             {
@@ -249,7 +256,12 @@ class Colony
         }
     };
 
-    std::pair<Block<BlockSize_>*, size_t> get_block(int index)
+    using BlockType = Block<BlockSize_, false>;
+    using BlockAllocator = RebindAllocator<BlockType>;
+    using BlockAllocatorTraits = std::allocator_traits<BlockAllocator>;
+    using FreeList = std::list<BlockType*, RebindAllocator<BlockType*>>;
+
+    std::pair<BlockType*, size_t> get_block(int index)
     {
         auto block_it = colony_array;
 
@@ -270,18 +282,24 @@ class Colony
     }
 
 
-    using FreeList = std::list<Block<BlockSize_>*>;
-
-    using BlockType = Block<BlockSize_>;
-
+    [[no_unique_address]] BlockAllocator block_allocator;
     size_t current_size = 0ull;
     BlockType* colony_array = nullptr;
-    FreeList free_list;
+    FreeList free_list{RebindAllocator<BlockType*>(block_allocator)};
 
 
     void allocate_new_block()
     {
-        auto new_block = new BlockType();
+        BlockType* new_block = BlockAllocatorTraits::allocate(block_allocator, 1);
+        try
+        {
+            std::construct_at(new_block, Allocator_(block_allocator));
+        }
+        catch (...)
+        {
+            BlockAllocatorTraits::deallocate(block_allocator, new_block, 1);
+            throw;
+        }
 
         auto it = colony_array;
         if (!colony_array)
@@ -301,10 +319,24 @@ class Colony
 
 public:
     Colony() = default;
+    explicit Colony(const Allocator_& allocator) : block_allocator(allocator)
+    {
+    }
+
     ~Colony()
     {
-        delete colony_array;
-        colony_array = nullptr;
+        while (colony_array)
+        {
+            BlockType* next = colony_array->get_next();
+            std::destroy_at(colony_array);
+            BlockAllocatorTraits::deallocate(block_allocator, colony_array, 1);
+            colony_array = next;
+        }
+    }
+
+    [[nodiscard]] Allocator_ get_allocator() const noexcept
+    {
+        return Allocator_(block_allocator);
     }
 
     template<typename T = Ty_>
@@ -315,7 +347,7 @@ public:
             allocate_new_block();
         }
 
-        Block<BlockSize_>* block = free_list.back();
+        BlockType* block = free_list.back();
         block->insert(std::forward<T>(element));
         ++current_size;
 
@@ -400,3 +432,9 @@ public:
         return Iterator(this, current_size);
     }
 };
+
+namespace pmr
+{
+    template<typename Ty_, size_t BlockSize_ = 16ull>
+    using Colony = ::Colony<Ty_, BlockSize_, std::pmr::polymorphic_allocator<Ty_>>;
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "HashMap.h"
+
+// Hash map shared between threads. The key space is split over a power of two number of shards, each one a
+// ClosedHashMap behind its own reader-writer lock, so threads only contend when they hit the same shard.
+// A key picks its shard from the high bits of the mixed hash and the table inside uses the low ones,
+// and each table grows on its own one bucket at a time, so a resize never stops the other shards.
+// Every member may be called from any thread.
+template<typename K, typename V, typename Hash_ = std::hash<K>, typename KeyEqual_ = std::equal_to<K>>
+class ConcurrentHashMap
+{
+    static constexpr size_t cache_line_size = 64ull;
+
+    using Map = ClosedHashMap::HashMap<K, V, Hash_, KeyEqual_, HashMapPolicy::PowerOfTwoIndexing>;
+
+    // Same rule as the shard maps: other key types are looked up without conversion when Hash_ and KeyEqual_
+    // are transparent.
+    template<typename Key_>
+    static constexpr bool is_lookup_key = std::same_as<std::remove_cvref_t<Key_>, K> ||
+                                          HashMapPolicy::Transparent<Hash_, KeyEqual_>;
+
+    // Padded so that two shards never share the cache line of their lock.
+    struct alignas(cache_line_size) Shard
+    {
+        mutable std::shared_mutex mutex;
+        Map map;
+
+        Shard(const Hash_& hash, const KeyEqual_& equal) : map(hash, equal)
+        {
+        }
+    };
+
+    // Shards are neither copyable nor movable because of their lock, so they are built in place.
+    Shard* shards = nullptr;
+    size_t shard_count;
+    size_t shard_shift;
+
+    [[no_unique_address]] Hash_ hasher;
+
+    template<typename Key_>
+    Shard& get_shard(const Key_& key) const
+    {
+        const size_t hash = HashMapPolicy::PowerOfTwoIndexing::mix(hasher(key));
+        return shards[shard_count == 1ull ? 0ull : hash >> shard_shift];
+    }
+
+public:
+    // `shard_count` is rounded up to a power of two. A few shards per thread keeps the odds of two threads
+    // meeting on one lock low.
+    explicit ConcurrentHashMap(const size_t shard_count_ = 4ull * std::max(1u, std::thread::hardware_concurrency()),
+                               const Hash_& hash = Hash_(), const KeyEqual_& equal = KeyEqual_()) :
+        shard_count(std::bit_ceil(std::max(shard_count_, size_t(1ull)))),
+        shard_shift(std::numeric_limits<size_t>::digits - std::countr_zero(shard_count)),
+        hasher(hash)
+    {
+        shards = std::allocator<Shard>().allocate(shard_count);
+        size_t constructed = 0ull;
+        try
+        {
+            for (; constructed < shard_count; ++constructed)
+            {
+                std::construct_at(shards + constructed, hash, equal);
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(shards, constructed);
+            std::allocator<Shard>().deallocate(shards, shard_count);
+            throw;
+        }
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    ~ConcurrentHashMap()
+    {
+        std::destroy_n(shards, shard_count);
+        std::allocator<Shard>().deallocate(shards, shard_count);
+    }
+
+    // Returns a copy of the value, the element may be changed or removed as soon as the shard is unlocked.
+    std::optional<V> find(const K& key) const
+    {
+        return find<K>(key);
+    }
+
+    template<typename Key_>
+    requires is_lookup_key<Key_>
+    std::optional<V> find(const Key_& key) const
+    {
+        const Shard& shard = get_shard(key);
+        std::shared_lock lock(shard.mutex);
+        if (const V* value = shard.map.try_find(key))
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    bool contains(const K& key) const
+    {
+        return contains<K>(key);
+    }
+
+    template<typename Key_>
+    requires is_lookup_key<Key_>
+    bool contains(const Key_& key) const
+    {
+        const Shard& shard = get_shard(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.try_find(key) != nullptr;
+    }
+
+    // Returns true when the key was inserted, false when its value was replaced.
+    // A key of another type than K is converted only when it is not in the map yet.
+    template<typename Key_ = K, typename Value_ = V>
+    bool insert_or_assign(Key_&& key, Value_&& value)
+    {
+        if constexpr (!is_lookup_key<Key_>)
+        {
+            return insert_or_assign(K(std::forward<Key_>(key)), std::forward<Value_>(value));
+        }
+        else
+        {
+            Shard& shard = get_shard(key);
+            std::unique_lock lock(shard.mutex);
+            const size_t previous_size = shard.map.get_size();
+            shard.map.insert(std::forward<Key_>(key), std::forward<Value_>(value));
+            return shard.map.get_size() != previous_size;
+        }
+    }
+
+    // Returns true when the key was present.
+    bool erase(const K& key)
+    {
+        return erase<K>(key);
+    }
+
+    template<typename Key_>
+    requires is_lookup_key<Key_>
+    bool erase(const Key_& key)
+    {
+        Shard& shard = get_shard(key);
+        std::unique_lock lock(shard.mutex);
+        const size_t previous_size = shard.map.get_size();
+        shard.map.remove(key);
+        return shard.map.get_size() != previous_size;
+    }
+
+    // Calls `update` on the value of `key` while its shard is locked, a value-initialized V is inserted first
+    // when the key is absent. `update` must not call back into the map. Returns true when the key was inserted.
+    template<typename Function_>
+    bool upsert(const K& key, Function_&& update)
+    {
+        return upsert<K>(key, std::forward<Function_>(update));
+    }
+
+    template<typename Key_, typename Function_>
+    requires is_lookup_key<Key_>
+    bool upsert(const Key_& key, Function_&& update)
+    {
+        Shard& shard = get_shard(key);
+        std::unique_lock lock(shard.mutex);
+        auto [value, inserted] = shard.map.get_or_insert(key);
+        std::invoke(std::forward<Function_>(update), value);
+        return inserted;
+    }
+
+    // Calls `function(key, value)` on every element, one shard at a time under its shared lock. Weakly
+    // consistent: each shard is seen in a single state, but shards are visited at different moments, so
+    // concurrent changes may or may not show up. `function` must not call back into the map.
+    template<typename Function_>
+    void for_each(Function_&& function) const
+    {
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            const Shard& shard = shards[i];
+            std::shared_lock lock(shard.mutex);
+            for (const auto& [key, value] : shard.map)
+            {
+                std::invoke(function, key, value);
+            }
+        }
+    }
+
+    // Sum of the shard sizes, each read at a different moment while other threads write.
+    [[nodiscard]] size_t get_size() const
+    {
+        size_t size = 0ull;
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            std::shared_lock lock(shards[i].mutex);
+            size += shards[i].map.get_size();
+        }
+        return size;
+    }
+
+    [[nodiscard]] size_t get_shard_count() const noexcept
+    {
+        return shard_count;
+    }
+};
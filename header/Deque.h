@@ -3,14 +3,18 @@
 //
 #pragma once
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <utility>
 
-template<typename T, size_t DequeSize_ = 100ull, size_t ChunkSize_ = 8ull>
+template<typename T, size_t DequeSize_ = 100ull, size_t ChunkSize_ = 8ull, typename Allocator_ = std::allocator<T>>
 class Deque
 {
+	using AllocatorTraits = std::allocator_traits<Allocator_>;
+
 	class Chunk
 	{
+		[[no_unique_address]] Allocator_ allocator;
 		T* data{ nullptr };
 		size_t start_chunk_index{ ChunkSize_ };
 		size_t end_chunk_index{ 0ull };
@@ -20,6 +24,10 @@ class Deque
 		friend void swap(Chunk& first, Chunk& second) noexcept
 		{
 			using std::swap;
+			if constexpr (AllocatorTraits::propagate_on_container_swap::value)
+			{
+				swap(first.allocator, second.allocator);
+			}
 			swap(first.data, second.data);
 			swap(first.start_chunk_index, second.start_chunk_index);
 			swap(first.end_chunk_index, second.end_chunk_index);
@@ -29,7 +37,7 @@ class Deque
 
 		void copy_resources_from(const Chunk& source)
 		{
-			data = static_cast<T*>(::operator new(sizeof(T) * ChunkSize_));
+			data = AllocatorTraits::allocate(allocator, ChunkSize_);
 			start_chunk_index = source.start_chunk_index;
 			end_chunk_index = source.end_chunk_index;
 
@@ -62,9 +70,9 @@ class Deque
 
 	public:
 
-		Chunk()
+		explicit Chunk(const Allocator_& allocator_) : allocator(allocator_)
 		{
-			data = static_cast<T*>(::operator new(sizeof(T) * ChunkSize_));
+			data = AllocatorTraits::allocate(allocator, ChunkSize_);
 		}
 
 		~Chunk()
@@ -86,10 +94,14 @@ class Deque
 				}
 			}
 
-			::operator delete(data);
+			AllocatorTraits::deallocate(allocator, data, ChunkSize_);
 		}
 
-		Chunk(const Chunk& other)
+		Chunk(const Chunk& other) : Chunk(other, other.allocator)
+		{
+		}
+
+		Chunk(const Chunk& other, const Allocator_& allocator_) : allocator(allocator_)
 		{
 			copy_resources_from(other);
 		}
@@ -215,8 +227,13 @@ class Deque
 	};
 
 
+	using ChunkAllocator = typename AllocatorTraits::template rebind_alloc<Chunk>;
+	using ChunkAllocatorTraits = std::allocator_traits<ChunkAllocator>;
+
 	static constexpr size_t starting_pos = (DequeSize_ + 2 - 1) / 2;
 
+	[[no_unique_address]] Allocator_ allocator;
+
 	size_t chunk_start_index{ starting_pos };
 	size_t chunk_end_index{ starting_pos };
 	size_t current_size{ 0ull };
@@ -228,11 +245,37 @@ class Deque
 		allocate_at(starting_pos);
 	}
 
+	template<typename... Args>
+	Chunk* new_chunk(Args&&... args)
+	{
+		ChunkAllocator chunk_allocator(allocator);
+		Chunk* chunk = ChunkAllocatorTraits::allocate(chunk_allocator, 1);
+		try
+		{
+			std::construct_at(chunk, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			ChunkAllocatorTraits::deallocate(chunk_allocator, chunk, 1);
+			throw;
+		}
+		return chunk;
+	}
+
+	void delete_chunk(Chunk* chunk)
+	{
+		if (!chunk) return;
+
+		ChunkAllocator chunk_allocator(allocator);
+		std::destroy_at(chunk);
+		ChunkAllocatorTraits::deallocate(chunk_allocator, chunk, 1);
+	}
+
 	void allocate_at(size_t index)
 	{
 		if (map[index] == nullptr)
 		{
-			map[index] = new Chunk();
+			map[index] = new_chunk(allocator);
 		}
 	}
 
@@ -291,20 +334,33 @@ class Deque
 
 public:
 	Deque() = default;
-	Deque(const Deque& other) : chunk_start_index(other.chunk_start_index), chunk_end_index(other.chunk_end_index), current_size(other.current_size)
+	explicit Deque(const Allocator_& allocator_) : allocator(allocator_)
+	{
+	}
+
+	Deque(const Deque& other) : Deque(other, AllocatorTraits::select_on_container_copy_construction(other.allocator))
+	{
+	}
+
+	Deque(const Deque& other, const Allocator_& allocator_) : allocator(allocator_), chunk_start_index(other.chunk_start_index), chunk_end_index(other.chunk_end_index), current_size(other.current_size)
 	{
 		for (size_t i = 0; i < DequeSize_; ++i)
 		{
 			if (other.map[i])
 			{
-				map[i] = new Chunk(*other.map[i]);
+				map[i] = new_chunk(*other.map[i], allocator);
 			}
 		}
 	}
 
-	Deque& operator=(Deque deque)
+	// The copy is made with this deque's allocator so the chunks keep coming from the same place.
+	Deque& operator=(const Deque& other)
 	{
-		swap(*this,deque);
+		if (this != &other)
+		{
+			Deque deque(other, allocator);
+			swap(*this, deque);
+		}
 		return *this;
 	}
 
@@ -312,13 +368,18 @@ public:
 	{
 		for (size_t i = 0; i < DequeSize_; ++i)
 		{
-			delete map[i];
+			delete_chunk(map[i]);
 		}
 	}
 
+	// As with the standard containers, allocators that don't propagate on swap must compare equal.
 	friend void swap(Deque& first, Deque& second) noexcept
 	{
 		using std::swap;
+		if constexpr (AllocatorTraits::propagate_on_container_swap::value)
+		{
+			swap(first.allocator, second.allocator);
+		}
 
 		swap(first.chunk_end_index, second.chunk_end_index);
 		swap(first.chunk_start_index, second.chunk_start_index);
@@ -326,6 +387,11 @@ public:
 		swap(first.map, second.map);
 	}
 
+	[[nodiscard]] Allocator_ get_allocator() const noexcept
+	{
+		return allocator;
+	}
+
 	[[nodiscard]] size_t size() const noexcept
 	{
 		return current_size;
@@ -463,7 +529,7 @@ public:
 	template<typename U = T>
 	class Iterator : public std::iterator<std::random_access_iterator_tag, U>
 	{
-		friend class Deque<T>;
+		friend class Deque;
 
 		using difference_type = std::ptrdiff_t;
 		Deque* deque = nullptr;
@@ -554,3 +620,9 @@ public:
 		return Iterator<T>(this, size());
 	}
 };
+
+namespace pmr
+{
+	template<typename T, size_t DequeSize_ = 100ull, size_t ChunkSize_ = 8ull>
+	using Deque = ::Deque<T, DequeSize_, ChunkSize_, std::pmr::polymorphic_allocator<T>>;
+}
@@ -4,220 +4,1605 @@
 //
 
 #pragma once
-#include <list>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <utility>
 #include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASH_MAP_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Policies shared by the hash maps.
+namespace HashMapPolicy
+{
+    // Reduces hashes with a division, works with any table size.
+    struct ModuloIndexing
+    {
+        static constexpr size_t initial_capacity = 10ull;
+
+        static size_t mix(const size_t hash) noexcept
+        {
+            return hash;
+        }
+
+        static size_t reduce(const size_t hash, const size_t capacity) noexcept
+        {
+            return hash % capacity;
+        }
+    };
+
+    // Keeps table sizes to powers of two and reduces hashes with a mask. Hashes are first scrambled
+    // with a Fibonacci multiply so that identity hashes (std::hash of integers) still spread over the low bits.
+    struct PowerOfTwoIndexing
+    {
+        static constexpr size_t initial_capacity = 16ull;
+
+        static size_t mix(size_t hash) noexcept
+        {
+            hash *= 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 32);
+        }
+
+        static size_t reduce(const size_t hash, const size_t capacity) noexcept
+        {
+            return hash & (capacity - 1);
+        }
+    };
+
+    // Visits the cells following the home cell one by one.
+    struct LinearProbing
+    {
+        static size_t get_offset(size_t, const size_t attempt) noexcept
+        {
+            return attempt;
+        }
+    };
+
+    // Visits the home cell plus 1, 3, 6, 10... which breaks up clusters of neighbouring keys. Reaches every
+    // cell of a power of two table only, use with PowerOfTwoIndexing.
+    struct QuadraticProbing
+    {
+        static size_t get_offset(size_t, const size_t attempt) noexcept
+        {
+            return attempt * (attempt + 1) / 2;
+        }
+    };
+
+    // Steps by an odd stride taken from the upper half of the hash, so keys sharing a home cell follow different
+    // sequences. Reaches every cell of a power of two table only, use with PowerOfTwoIndexing.
+    struct DoubleHashing
+    {
+        static size_t get_offset(const size_t hash, const size_t attempt) noexcept
+        {
+            return attempt * ((hash >> 32) | 1ull);
+        }
+    };
+
+    // Lets a std::string keyed map be searched with a std::string_view or a C string without building a std::string.
+    // Use with std::equal_to<>.
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const std::string_view key) const noexcept
+        {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    // Hash_ and KeyEqual_ accept other types than the key type itself.
+    template<typename Hash_, typename KeyEqual_>
+    concept Transparent = requires
+    {
+        typename Hash_::is_transparent;
+        typename KeyEqual_::is_transparent;
+    };
+}
+
+namespace HashMapDetail
+{
+    // Number of keys the batched operations hash and prefetch ahead of resolving them. Enough misses in flight
+    // to hide a DRAM access, few enough that the prefetched lines are still in L1 when they are used.
+    constexpr size_t batch_width = 16ull;
+
+    inline void prefetch(const void* address) noexcept
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#elif defined(HASH_MAP_HAS_SSE2)
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    template<typename Key_, typename Value_>
+    void check_batch(const std::span<Key_> keys, const std::span<Value_> values)
+    {
+        if (values.size() < keys.size())
+        {
+            throw std::invalid_argument("batch spans are smaller than the key span");
+        }
+    }
+}
 
 namespace ClosedHashMap
 {
 
-    template<typename K, typename V>
+    // Hash_ and KeyEqual_ may be transparent (see HashMapPolicy::StringHash) to look keys up from other types.
+    // Indexing_ picks how hashes are reduced to a bucket, see HashMapPolicy.
+    template<typename K, typename V, typename Hash_ = std::hash<K>, typename KeyEqual_ = std::equal_to<K>,
+             typename Indexing_ = HashMapPolicy::ModuloIndexing>
     class HashMap
     {
-        class Bucket
+        // Types accepted by find and remove, and by insert without converting to K first.
+        template<typename Key_>
+        static constexpr bool is_lookup_key = std::same_as<std::remove_cvref_t<Key_>, K> ||
+                                              HashMapPolicy::Transparent<Hash_, KeyEqual_>;
+
+        static constexpr size_t end_of_chain = std::numeric_limits<size_t>::max();
+
+        // Chain link stored next to the element, with the hash of its key so that walking a chain
+        // compares keys only on a hash match and splitting a bucket never hashes a key again.
+        struct Entry
+        {
+            size_t hash;
+            size_t next;
+            std::pair<K,V> pair;
+
+            template<typename Key_ = K, typename Value_ = V>
+            Entry(const size_t hash_, const size_t next_, Key_&& key, Value_&& value) :
+                hash(hash_), next(next_), pair(std::forward<Key_>(key), std::forward<Value_>(value))
+            {
+            }
+        };
+
+        // Entries packed in fixed-size pages and addressed by index. Removing an entry moves the last one
+        // into its slot, so the pool stays dense, and adding a page never moves the existing entries.
+        class EntryPool
         {
+            static constexpr size_t PageSize = 256ull;
+
+            struct Page
+            {
+                alignas(Entry) std::byte storage[PageSize * sizeof(Entry)];
+            };
+
+            std::vector<std::unique_ptr<Page>> pages;
+            size_t size = 0ull;
+
+            Entry* slot(const size_t index) const noexcept
+            {
+                return reinterpret_cast<Entry*>(pages[index / PageSize]->storage) + index % PageSize;
+            }
 
         public:
-            using Pair = std::pair<K,V>;
+            EntryPool() = default;
+
+            EntryPool(const EntryPool& other)
+            {
+                for (size_t i = 0ull; i < other.size; ++i)
+                {
+                    emplace_back(other[i]);
+                }
+            }
+
+            EntryPool(EntryPool&& other) noexcept : pages(std::move(other.pages)), size(std::exchange(other.size, 0ull))
+            {
+            }
+
+            EntryPool& operator=(EntryPool other) noexcept
+            {
+                swap(*this, other);
+                return *this;
+            }
+
+            ~EntryPool()
+            {
+                while (size)
+                {
+                    pop_back();
+                }
+            }
+
+            friend void swap(EntryPool& first, EntryPool& second) noexcept
+            {
+                using std::swap;
+                swap(first.pages, second.pages);
+                swap(first.size, second.size);
+            }
+
+            [[nodiscard]] size_t get_size() const noexcept
+            {
+                return size;
+            }
+
+            Entry& operator[](const size_t index) noexcept
+            {
+                return *slot(index);
+            }
+
+            const Entry& operator[](const size_t index) const noexcept
+            {
+                return *slot(index);
+            }
+
+            template<typename... Args>
+            Entry& emplace_back(Args&&... args)
+            {
+                if (size == pages.size() * PageSize)
+                {
+                    pages.push_back(std::unique_ptr<Page>(new Page));
+                }
+
+                Entry* entry = std::construct_at(slot(size), std::forward<Args>(args)...);
+                ++size;
+                return *entry;
+            }
+
+            void pop_back() noexcept
+            {
+                std::destroy_at(slot(--size));
+            }
+        };
+
+        // Linear hashing: the table grows one bucket at a time instead of doubling at once. Buckets below
+        // `split_index` have been split in the current round and are addressed with twice the round's bucket
+        // count. Each bucket holds the index of the first entry of its chain, and a deque never moves them,
+        // so growing costs one bucket split and never a full rehash.
+        std::deque<size_t> m_map;
+        EntryPool entries;
+        size_t round_bucket_count = Indexing_::initial_capacity;
+        size_t split_index = 0ull;
+        float max_load_factor = 1.f;
+
+        [[no_unique_address]] Hash_ hasher;
+        [[no_unique_address]] KeyEqual_ key_equal;
+
+        template<typename Key_>
+        size_t get_hash(const Key_& key) const
+        {
+            return Indexing_::mix(hasher(key));
+        }
+
+        size_t get_bucket(const size_t hash) const noexcept
+        {
+            size_t hash_index = Indexing_::reduce(hash, round_bucket_count);
+            if (hash_index < split_index)
+            {
+                hash_index = Indexing_::reduce(hash, round_bucket_count * 2);
+            }
+            return hash_index;
+        }
+
+        // Index of the entry with `key`, or end_of_chain when the key is absent.
+        template<typename Key_>
+        size_t find_link(const Key_& key, const size_t hash) const
+        {
+            const size_t* link = &m_map[get_bucket(hash)];
+            while (*link != end_of_chain)
+            {
+                const Entry& entry = entries[*link];
+                if (entry.hash == hash && key_equal(entry.pair.first, key))
+                    break;
+
+                link = &entries[*link].next;
+            }
+            return *link;
+        }
+
+        // Unlinks the entry at `index` from its chain, then fills its slot with the last entry of the pool.
+        void erase_entry(const size_t index)
+        {
+            size_t* link = &m_map[get_bucket(entries[index].hash)];
+            while (*link != index)
+            {
+                link = &entries[*link].next;
+            }
+            *link = entries[index].next;
+
+            const size_t last = entries.get_size() - 1;
+            if (index != last)
+            {
+                link = &m_map[get_bucket(entries[last].hash)];
+                while (*link != last)
+                {
+                    link = &entries[*link].next;
+                }
+                *link = index;
+                entries[index] = std::move(entries[last]);
+            }
+            entries.pop_back();
+        }
+
+        // Appends the bucket pairing with `split_index` and relinks the entries that now hash to it.
+        void split_next_bucket()
+        {
+            m_map.push_back(end_of_chain);
+            size_t& destination = m_map.back();
+
+            size_t* link = &m_map[split_index];
+            while (*link != end_of_chain)
+            {
+                Entry& entry = entries[*link];
+                if (Indexing_::reduce(entry.hash, round_bucket_count * 2) != split_index)
+                {
+                    const size_t moved = *link;
+                    *link = entry.next;
+                    entry.next = destination;
+                    destination = moved;
+                }
+                else
+                {
+                    link = &entry.next;
+                }
+            }
+
+            if (++split_index == round_bucket_count)
+            {
+                round_bucket_count *= 2;
+                split_index = 0ull;
+            }
+        }
+
+        // Links a new entry at the head of its chain, once the key is known to be absent. Returns its index.
+        // Splits as many buckets as the max load factor requires, about ceil(1 / max_load_factor) per insert.
+        template<typename Key_, typename Value_>
+        size_t append_entry(Key_&& key, const size_t hash, Value_&& value)
+        {
+            while (static_cast<float>(entries.get_size() + 1) > max_load_factor * static_cast<float>(m_map.size()))
+            {
+                split_next_bucket();
+            }
+
+            size_t& head = m_map[get_bucket(hash)];
+            entries.emplace_back(hash, head, std::forward<Key_>(key), std::forward<Value_>(value));
+            head = entries.get_size() - 1;
+            return head;
+        }
+
+        template<typename Key_, typename Value_>
+        void insert_hashed(Key_&& key, const size_t hash, Value_&& value)
+        {
+            if (const size_t index = find_link(key, hash); index != end_of_chain)
+            {
+                entries[index].pair.second = std::forward<Value_>(value);
+                return;
+            }
+
+            append_entry(std::forward<Key_>(key), hash, std::forward<Value_>(value));
+        }
+
+        // Hashes a group of keys and prefetches their buckets, then the first entry of each chain, so that
+        // the cache misses of the whole group overlap instead of stalling one find after the other.
+        void prefetch_batch(const std::span<const K> keys, const std::span<size_t> hashes)
+        {
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                hashes[i] = get_hash(keys[i]);
+                HashMapDetail::prefetch(&m_map[get_bucket(hashes[i])]);
+            }
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                if (const size_t head = m_map[get_bucket(hashes[i])]; head != end_of_chain)
+                {
+                    HashMapDetail::prefetch(&entries[head]);
+                }
+            }
+        }
+
+    public:
+
+        HashMap() : HashMap(Hash_(), KeyEqual_())
+        {
+        }
+
+        explicit HashMap(const Hash_& hash, const KeyEqual_& equal = KeyEqual_()) : hasher(hash), key_equal(equal)
+        {
+            m_map.resize(round_bucket_count, end_of_chain);
+        }
+
+        // Splits buckets while the element count would exceed `max_load_factor` times the bucket count.
+        // A key of another type than K is converted only when it is not in the map yet.
+        template<typename Key_ = K, typename Value_ = V>
+        void insert(Key_&& key, Value_&& value)
+        {
+            if constexpr (!is_lookup_key<Key_>)
+            {
+                insert(K(std::forward<Key_>(key)), std::forward<Value_>(value));
+            }
+            else
+            {
+                const size_t hash = get_hash(key);
+                insert_hashed(std::forward<Key_>(key), hash, std::forward<Value_>(value));
+            }
+        }
+
+        // Returns the value of `key`, and true when a value-initialized V had to be inserted for it, with a
+        // single lookup. Entries never move on insert, so the reference stays valid until the next remove.
+        template<typename Key_ = K>
+        std::pair<V&, bool> get_or_insert(Key_&& key)
+        {
+            if constexpr (!is_lookup_key<Key_>)
+            {
+                return get_or_insert(K(std::forward<Key_>(key)));
+            }
+            else
+            {
+                const size_t hash = get_hash(key);
+                if (const size_t index = find_link(key, hash); index != end_of_chain)
+                {
+                    return {entries[index].pair.second, false};
+                }
+                return {entries[append_entry(std::forward<Key_>(key), hash, V())].pair.second, true};
+            }
+        }
+
+        V& find(const K& key)
+        {
+            return find<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        V& find(const Key_& key)
+        {
+            const size_t index = find_link(key, get_hash(key));
+            if (index == end_of_chain)
+            {
+                throw std::out_of_range("Key doesn't exist");
+            }
+            return entries[index].pair.second;
+        }
+
+        // out[i] points to the value of keys[i], or is null when the key is absent. The pointers stay valid
+        // until the next insert or remove.
+        void find_batch(const std::span<const K> keys, const std::span<V*> out)
+        {
+            HashMapDetail::check_batch(keys, out);
+            std::array<size_t, HashMapDetail::batch_width> hashes;
+            for (size_t first = 0; first < keys.size(); first += HashMapDetail::batch_width)
+            {
+                const auto batch = keys.subspan(first, std::min(HashMapDetail::batch_width, keys.size() - first));
+                prefetch_batch(batch, hashes);
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    const size_t index = find_link(batch[i], hashes[i]);
+                    out[first + i] = index == end_of_chain ? nullptr : &entries[index].pair.second;
+                }
+            }
+        }
+
+        // Inserts or assigns values[i] to keys[i], in order.
+        void insert_batch(const std::span<const K> keys, const std::span<const V> values)
+        {
+            HashMapDetail::check_batch(keys, values);
+            std::array<size_t, HashMapDetail::batch_width> hashes;
+            for (size_t first = 0; first < keys.size(); first += HashMapDetail::batch_width)
+            {
+                const auto batch = keys.subspan(first, std::min(HashMapDetail::batch_width, keys.size() - first));
+                prefetch_batch(batch, hashes);
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    insert_hashed(batch[i], hashes[i], values[first + i]);
+                }
+            }
+        }
+
+        // Same as find, but returns null instead of throwing when the key is absent.
+        V* try_find(const K& key)
+        {
+            return try_find<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        V* try_find(const Key_& key)
+        {
+            const size_t index = find_link(key, get_hash(key));
+            return index == end_of_chain ? nullptr : &entries[index].pair.second;
+        }
+
+        const V* try_find(const K& key) const
+        {
+            return try_find<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        const V* try_find(const Key_& key) const
+        {
+            const size_t index = find_link(key, get_hash(key));
+            return index == end_of_chain ? nullptr : &entries[index].pair.second;
+        }
+
+        void remove(const K& key)
+        {
+            remove<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        void remove(const Key_& key)
+        {
+            if (const size_t index = find_link(key, get_hash(key)); index != end_of_chain)
+            {
+                erase_entry(index);
+            }
+        }
+
+        // Doubles the bucket count at once by splitting every bucket.
+        void rehash()
+        {
+            for (size_t i = m_map.size(); i > 0ull; --i)
+            {
+                split_next_bucket();
+            }
+        }
+
+        [[nodiscard]] size_t get_size() const noexcept
+        {
+            return entries.get_size();
+        }
+
+        [[nodiscard]] size_t get_bucket_count() const noexcept
+        {
+            return m_map.size();
+        }
+
+        [[nodiscard]] float get_load_factor() const noexcept
+        {
+            return static_cast<float>(entries.get_size()) / static_cast<float>(m_map.size());
+        }
+
+        // Takes effect on the next insert, which splits as many buckets as needed to get back under it.
+        void set_max_load_factor(const float load_factor)
+        {
+            if (load_factor <= 0.f)
+            {
+                throw std::invalid_argument("max load factor must be positive");
+            }
+            max_load_factor = load_factor;
+        }
+
+        // Walks the entry pool, which is dense, so a full iteration is O(elements).
+        // Inserting invalidates iterators. Erasing moves the last element into the erased position.
+        template<typename Type>
+        class Iterator
+        {
+            friend class HashMap;
+            template<typename>
+            friend class Iterator;
+
+            using Map = std::conditional_t<std::is_const_v<Type>, const HashMap, HashMap>;
+
+            Map* map = nullptr;
+            size_t index = 0ull;
+
+            Iterator(Map* map_, const size_t index_) : map(map_), index(index_)
+            {
+            }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_cv_t<Type>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Type*;
+            using reference = Type&;
+
+            Iterator() = default;
+
+            // iterator converts to const_iterator.
+            template<typename Other>
+            requires (std::is_const_v<Type> && std::same_as<const Other, Type>)
+            Iterator(const Iterator<Other>& other) : map(other.map), index(other.index)
+            {
+            }
+
+            reference operator*() const
+            {
+                return map->entries[index].pair;
+            }
+
+            pointer operator->() const
+            {
+                return &map->entries[index].pair;
+            }
+
+            bool operator==(const Iterator & other) const
+            {
+                return other.map == map && index == other.index;
+            }
+
+            Iterator& operator++()
+            {
+                ++index;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+        };
+
+        using iterator = Iterator<std::pair<K,V>>;
+        using const_iterator = Iterator<const std::pair<K,V>>;
+
+        // Removes the element at `position` and returns the position of the following one.
+        iterator erase(const_iterator position)
+        {
+            erase_entry(position.index);
+            return iterator(this, position.index);
+        }
+
+        iterator begin()
+        {
+            return iterator(this, 0ull);
+        }
+
+        iterator end()
+        {
+            return iterator(this, entries.get_size());
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0ull);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, entries.get_size());
+        }
+    };
+}
+
+
+namespace OpenHashMap
+{
+    // Hash_ and KeyEqual_ may be transparent (see HashMapPolicy::StringHash) to look keys up from other types.
+    // Indexing_ picks how hashes are reduced to a cell and Probing_ the order in which cells are visited after
+    // a collision, see HashMapPolicy.
+    template<typename K, typename V, typename Hash_ = std::hash<K>, typename KeyEqual_ = std::equal_to<K>,
+             typename Indexing_ = HashMapPolicy::ModuloIndexing, typename Probing_ = HashMapPolicy::LinearProbing>
+    class HashMap
+    {
+        // Types accepted by find and remove, and by insert without converting to K first.
+        template<typename Key_>
+        static constexpr bool is_lookup_key = std::same_as<std::remove_cvref_t<Key_>, K> ||
+                                              HashMapPolicy::Transparent<Hash_, KeyEqual_>;
+
+        enum class State {EMPTY, OCCUPIED, TRASH};
+
+        struct Cell
+        {
+            State state = State::EMPTY;
+            std::pair<K,V> pair;
+        };
+
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        // Outcome of walking the probe sequence of a key: the cell holding it and the first cell it could be
+        // inserted in, npos when there is none.
+        struct Probe
+        {
+            size_t found = npos;
+            size_t free = npos;
+        };
+
+        std::vector<Cell> m_map;
+        size_t real_size = 0ull;
+        size_t trash_count = 0ull;
+        float max_load_factor = 0.75f;
+
+        [[no_unique_address]] Hash_ hasher;
+        [[no_unique_address]] KeyEqual_ key_equal;
+
+        template<typename Key_>
+        size_t get_hash(const Key_& key) const
+        {
+            return Indexing_::mix(hasher(key));
+        }
+
+        size_t get_index(const size_t hash, const size_t attempt) const noexcept
+        {
+            return Indexing_::reduce(hash + Probing_::get_offset(hash, attempt), m_map.size());
+        }
+
+        template<typename Key_>
+        Probe probe(const Key_& key) const
+        {
+            return probe(key, get_hash(key));
+        }
+
+        // Stops on the key, on the first empty cell, or once as many cells as the table holds were visited.
+        template<typename Key_>
+        Probe probe(const Key_& key, const size_t hash) const
+        {
+            Probe result;
+            for (size_t attempt = 0; attempt < m_map.size(); ++attempt)
+            {
+                const size_t index = get_index(hash, attempt);
+                const Cell& cell = m_map[index];
+                if (cell.state == State::OCCUPIED)
+                {
+                    if (key_equal(cell.pair.first, key))
+                    {
+                        result.found = index;
+                        return result;
+                    }
+                    continue;
+                }
+
+                if (result.free == npos)
+                {
+                    result.free = index;
+                }
+                if (cell.state == State::EMPTY)
+                {
+                    break;
+                }
+            }
+            return result;
+        }
+
+        bool exceeds_load(const size_t count, const size_t capacity) const noexcept
+        {
+            return static_cast<float>(count) > max_load_factor * static_cast<float>(capacity);
+        }
+
+        // Moves the occupied cells into a table of `capacity` cells, which also drops all the tombstones.
+        void resize(const size_t capacity)
+        {
+            auto previous = std::exchange(m_map, std::vector<Cell>(capacity));
+            trash_count = 0ull;
+
+            for (auto& element: previous)
+            {
+                if (element.state == State::OCCUPIED)
+                {
+                    size_t free;
+                    while ((free = probe(element.pair.first).free) == npos)
+                    {
+                        resize(m_map.size() * 2);
+                    }
+                    m_map[free].state = State::OCCUPIED;
+                    m_map[free].pair = std::move(element.pair);
+                }
+            }
+        }
+
+        // Returns a free cell on the probe sequence of `key`. Reusing a tombstone does not add to the used cells,
+        // so only a fresh empty cell can push the table over its max load factor. The table is then rebuilt at
+        // the same size when tombstones make up at least half of the limit, and doubled otherwise, which
+        // leaves O(capacity) insertions before the next rebuild either way.
+        template<typename Key_>
+        size_t make_room(const Key_& key, size_t free)
+        {
+            const bool reuses_trash = free != npos && m_map[free].state == State::TRASH;
+            if (free == npos || exceeds_load(real_size + trash_count + (reuses_trash ? 0ull : 1ull), m_map.size()))
+            {
+                const float limit = max_load_factor * static_cast<float>(m_map.size());
+                const bool mostly_elements = static_cast<float>(real_size + 1) > limit / 2.f;
+                resize(m_map.empty() ? Indexing_::initial_capacity : mostly_elements ? m_map.size() * 2 : m_map.size());
+
+                // Quadratic probing and double hashing may not reach every cell of a table that is not a power
+                // of two, the table then grows until the sequence of the key meets a free cell.
+                while ((free = probe(key).free) == npos)
+                {
+                    resize(m_map.size() * 2);
+                }
+            }
+            return free;
+        }
+
+        template<typename Key_, typename Value_>
+        void insert_hashed(Key_&& key, const size_t hash, Value_&& value)
+        {
+            const Probe result = probe(key, hash);
+            if (result.found != npos)
+            {
+                m_map[result.found].pair.second = std::forward<Value_>(value);
+                return;
+            }
+
+            Cell& cell = m_map[make_room(key, result.free)];
+            if (cell.state == State::TRASH)
+            {
+                --trash_count;
+            }
+            cell.pair.first = K(std::forward<Key_>(key));
+            cell.pair.second = std::forward<Value_>(value);
+            cell.state = State::OCCUPIED;
+            ++real_size;
+        }
+
+        // Hashes a group of keys and prefetches their home cells, so that the cache misses of the whole
+        // group overlap instead of stalling one find after the other.
+        void prefetch_batch(const std::span<const K> keys, const std::span<size_t> hashes) const
+        {
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                hashes[i] = get_hash(keys[i]);
+                if (!m_map.empty())
+                {
+                    HashMapDetail::prefetch(&m_map[get_index(hashes[i], 0ull)]);
+                }
+            }
+        }
+
+    public:
+        friend void swap(HashMap& first, HashMap& second) noexcept
+        {
+            using std::swap;
+            swap(first.m_map, second.m_map);
+            swap(first.real_size, second.real_size);
+            swap(first.trash_count, second.trash_count);
+            swap(first.max_load_factor, second.max_load_factor);
+            swap(first.hasher, second.hasher);
+            swap(first.key_equal, second.key_equal);
+        }
+
+        HashMap() : HashMap(Hash_(), KeyEqual_())
+        {
+        }
+
+        explicit HashMap(const Hash_& hash, const KeyEqual_& equal = KeyEqual_()) :
+            m_map(Indexing_::initial_capacity), hasher(hash), key_equal(equal)
+        {
+        }
+
+        HashMap(const HashMap& other) = default;
+
+        // Leaves `other` without cells, it allocates again on its next insertion.
+        HashMap(HashMap&& other) noexcept :
+            m_map(std::move(other.m_map)),
+            real_size(std::exchange(other.real_size, 0ull)),
+            trash_count(std::exchange(other.trash_count, 0ull)),
+            max_load_factor(other.max_load_factor),
+            hasher(other.hasher),
+            key_equal(other.key_equal)
+        {
+            other.m_map.clear();
+        }
+
+        HashMap& operator=(HashMap other)
+        {
+            swap(*this, other);
+            return *this;
+        }
+
+        // A key of another type than K is converted only when it is not in the map yet.
+        template<typename Key_ = K,typename Value_ = V>
+        void insert(Key_&& key, Value_&& value)
+        {
+            if constexpr (!is_lookup_key<Key_>)
+            {
+                insert(K(std::forward<Key_>(key)), std::forward<Value_>(value));
+            }
+            else
+            {
+                const size_t hash = get_hash(key);
+                insert_hashed(std::forward<Key_>(key), hash, std::forward<Value_>(value));
+            }
+        }
+
+        // out[i] points to the value of keys[i], or is null when the key is absent. The pointers stay valid
+        // until the next insert or remove.
+        void find_batch(const std::span<const K> keys, const std::span<V*> out)
+        {
+            HashMapDetail::check_batch(keys, out);
+            std::array<size_t, HashMapDetail::batch_width> hashes;
+            for (size_t first = 0; first < keys.size(); first += HashMapDetail::batch_width)
+            {
+                const auto batch = keys.subspan(first, std::min(HashMapDetail::batch_width, keys.size() - first));
+                prefetch_batch(batch, hashes);
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    const size_t index = probe(batch[i], hashes[i]).found;
+                    out[first + i] = index == npos ? nullptr : &m_map[index].pair.second;
+                }
+            }
+        }
+
+        // Inserts or assigns values[i] to keys[i], in order.
+        void insert_batch(const std::span<const K> keys, const std::span<const V> values)
+        {
+            HashMapDetail::check_batch(keys, values);
+            std::array<size_t, HashMapDetail::batch_width> hashes;
+            for (size_t first = 0; first < keys.size(); first += HashMapDetail::batch_width)
+            {
+                const auto batch = keys.subspan(first, std::min(HashMapDetail::batch_width, keys.size() - first));
+                prefetch_batch(batch, hashes);
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    insert_hashed(batch[i], hashes[i], values[first + i]);
+                }
+            }
+        }
+
+        void remove(const K& key)
+        {
+            remove<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        void remove(const Key_& key)
+        {
+            if (const size_t index = probe(key).found; index != npos)
+            {
+                m_map[index].state = State::TRASH;
+                --real_size;
+                ++trash_count;
+            }
+        }
+
+        V& find(const K& key)
+        {
+            return find<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        V& find(const Key_& key)
+        {
+            if (const size_t index = probe(key).found; index != npos)
+            {
+                return m_map[index].pair.second;
+            }
+            throw std::out_of_range("Key doesn't exist");
+        }
+
+        bool contains(const K& key) const
+        {
+            return contains<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        bool contains(const Key_& key) const
+        {
+            return probe(key).found != npos;
+        }
+
+        // Makes room for `count` elements without growing.
+        void reserve(const size_t count)
+        {
+            size_t capacity = m_map.empty() ? Indexing_::initial_capacity : m_map.size();
+            while (exceeds_load(count, capacity))
+            {
+                capacity *= 2;
+            }
+            if (capacity != m_map.size())
+            {
+                resize(capacity);
+            }
+        }
+
+        size_t get_size() const noexcept
+        {
+            return real_size;
+        }
+
+        bool is_empty() const noexcept
+        {
+            return real_size == 0ull;
+        }
+
+        size_t get_capacity() const noexcept
+        {
+            return m_map.size();
+        }
+
+        [[nodiscard]] float get_load_factor() const noexcept
+        {
+            return m_map.empty() ? 0.f : static_cast<float>(real_size) / static_cast<float>(m_map.size());
+        }
+
+        // Must lie in (0, 1), takes effect on the next insertion.
+        void set_max_load_factor(const float load_factor)
+        {
+            if (load_factor <= 0.f || load_factor >= 1.f)
+            {
+                throw std::invalid_argument("max load factor must be between 0 and 1");
+            }
+            max_load_factor = load_factor;
+        }
+
+        // Walks the cells in order and stops on occupied ones, a full iteration is O(capacity).
+        template<typename Type>
+        class Iterator
+        {
+            friend class HashMap;
+            template<typename>
+            friend class Iterator;
+
+            using Map = std::conditional_t<std::is_const_v<Type>, const HashMap, HashMap>;
+
+            Map* map = nullptr;
+            size_t index = 0ull;
+
+            Iterator(Map* map_, const size_t index_) : map(map_), index(index_)
+            {
+                skip_free_cells();
+            }
+
+            void skip_free_cells()
+            {
+                while (index < map->m_map.size() && map->m_map[index].state != State::OCCUPIED)
+                {
+                    ++index;
+                }
+            }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_cv_t<Type>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Type*;
+            using reference = Type&;
+
+            Iterator() = default;
+
+            // iterator converts to const_iterator.
+            template<typename Other>
+            requires (std::is_const_v<Type> && std::same_as<const Other, Type>)
+            Iterator(const Iterator<Other>& other) : map(other.map), index(other.index)
+            {
+            }
+
+            reference operator*() const
+            {
+                return map->m_map[index].pair;
+            }
+
+            pointer operator->() const
+            {
+                return &map->m_map[index].pair;
+            }
+
+            bool operator==(const Iterator & other) const
+            {
+                return other.map == map && index == other.index;
+            }
+
+            Iterator& operator++()
+            {
+                ++index;
+                skip_free_cells();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+        };
+
+        using iterator = Iterator<std::pair<K,V>>;
+        using const_iterator = Iterator<const std::pair<K,V>>;
+
+        // Removes the element at `position` and returns the position of the following one.
+        iterator erase(const_iterator position)
+        {
+            m_map[position.index].state = State::TRASH;
+            --real_size;
+            ++trash_count;
+            return iterator(this, position.index + 1);
+        }
+
+        iterator begin()
+        {
+            return iterator(this, 0ull);
+        }
+
+        iterator end()
+        {
+            return iterator(this, m_map.size());
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0ull);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, m_map.size());
+        }
+
+    };
+}
+
+
+// Open addressing map probing 16 slots at a time. A separate control byte array holds, for every slot,
+// either EMPTY, DELETED or the 7 low bits of the hash of its key, so a whole group is matched with a single
+// SSE2 compare and keys are only read when their hash fragment matches. Slots hold the pairs and are
+// never touched by a probe that misses.
+namespace SwissHashMap
+{
+    // Free control bytes have their sign bit set, full ones store a 7 bit hash fragment.
+    enum Control : int8_t
+    {
+        EMPTY = -128,
+        DELETED = -2
+    };
+
+    // 16 control bytes loaded at once. Bit i of the returned masks is set when slot i of the group matches.
+    class Group
+    {
+#if defined(HASH_MAP_HAS_SSE2)
+        __m128i control;
+#else
+        std::array<int8_t, 16> control;
+
+        uint32_t match_if(auto predicate) const noexcept
+        {
+            uint32_t mask = 0u;
+            for (size_t i = 0; i < width; ++i)
+            {
+                mask |= static_cast<uint32_t>(predicate(control[i])) << i;
+            }
+            return mask;
+        }
+#endif
+    public:
+        static constexpr size_t width = 16ull;
+
+        explicit Group(const int8_t* position) noexcept
+        {
+#if defined(HASH_MAP_HAS_SSE2)
+            control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+#else
+            std::copy_n(position, width, control.begin());
+#endif
+        }
+
+        uint32_t match(const int8_t fragment) const noexcept
+        {
+#if defined(HASH_MAP_HAS_SSE2)
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(fragment))));
+#else
+            return match_if([fragment](const int8_t byte) { return byte == fragment; });
+#endif
+        }
+
+        uint32_t match_empty() const noexcept
+        {
+            return match(EMPTY);
+        }
+
+        // EMPTY or DELETED.
+        uint32_t match_free() const noexcept
+        {
+#if defined(HASH_MAP_HAS_SSE2)
+            return static_cast<uint32_t>(_mm_movemask_epi8(control));
+#else
+            return match_if([](const int8_t byte) { return byte < 0; });
+#endif
+        }
+    };
+
+    // Hash_ and KeyEqual_ may be transparent (see HashMapPolicy::StringHash) to look keys up from other types.
+    // The capacity is a power of two multiple of Group::width and the table grows past a 7/8 load factor.
+    template<typename K, typename V, typename Hash_ = std::hash<K>, typename KeyEqual_ = std::equal_to<K>>
+    class HashMap
+    {
+        template<typename Key_>
+        static constexpr bool is_lookup_key = std::same_as<std::remove_cvref_t<Key_>, K> ||
+                                              HashMapPolicy::Transparent<Hash_, KeyEqual_>;
+
+        using Slot = std::pair<K,V>;
+        using SlotAllocator = std::allocator<Slot>;
+        using SlotAllocatorTraits = std::allocator_traits<SlotAllocator>;
+
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        std::vector<int8_t> control;
+        Slot* slots = nullptr;
+        size_t real_size = 0ull;
+        size_t deleted_count = 0ull;
+
+        [[no_unique_address]] SlotAllocator allocator;
+        [[no_unique_address]] Hash_ hasher;
+        [[no_unique_address]] KeyEqual_ key_equal;
+
+        template<typename Key_>
+        size_t get_hash(const Key_& key) const
+        {
+            return HashMapPolicy::PowerOfTwoIndexing::mix(hasher(key));
+        }
+
+        static int8_t get_fragment(const size_t hash) noexcept
+        {
+            return static_cast<int8_t>(hash & 0x7F);
+        }
+
+        size_t get_growth_limit() const noexcept
+        {
+            return control.size() - control.size() / 8;
+        }
+
+        // Groups are visited with triangular steps, which reach every group of a power of two table.
+        // Returns the first group for which `visit` returns true.
+        template<typename Visitor_>
+        size_t probe(const size_t hash, Visitor_ visit) const
+        {
+            const size_t group_mask = control.size() / Group::width - 1;
+            size_t group = (hash >> 7) & group_mask;
+            for (size_t step = 1; !visit(group * Group::width, Group(&control[group * Group::width])); ++step)
+            {
+                group = (group + step) & group_mask;
+            }
+            return group;
+        }
+
+        template<typename Key_>
+        size_t find_index(const Key_& key) const
+        {
+            if (real_size == 0ull)
+            {
+                return npos;
+            }
+
+            const size_t hash = get_hash(key);
+            size_t index = npos;
+            probe(hash, [&](const size_t first, const Group& group)
+            {
+                for (uint32_t mask = group.match(get_fragment(hash)); mask != 0u; mask &= mask - 1u)
+                {
+                    const size_t candidate = first + std::countr_zero(mask);
+                    if (key_equal(slots[candidate].first, key))
+                    {
+                        index = candidate;
+                        return true;
+                    }
+                }
+                return group.match_empty() != 0u;
+            });
+            return index;
+        }
+
+        // First EMPTY or DELETED slot on the probe sequence of `hash`, the table always has one.
+        size_t find_free_index(const size_t hash) const
+        {
+            size_t index = npos;
+            probe(hash, [&](const size_t first, const Group& group)
+            {
+                if (const uint32_t mask = group.match_free())
+                {
+                    index = first + std::countr_zero(mask);
+                    return true;
+                }
+                return false;
+            });
+            return index;
+        }
+
+        void erase_index(const size_t index)
+        {
+            std::destroy_at(&slots[index]);
+            --real_size;
+
+            // A group that still has an empty slot never let a probe go past it, so the slot can go back to EMPTY.
+            // Otherwise a key further down some probe sequence may depend on it and it becomes a tombstone.
+            if (Group(&control[index & ~(Group::width - 1)]).match_empty() != 0u)
+            {
+                control[index] = EMPTY;
+            }
+            else
+            {
+                control[index] = DELETED;
+                ++deleted_count;
+            }
+        }
+
+        void destroy_slots() noexcept
+        {
+            for (size_t i = 0; i < control.size(); ++i)
+            {
+                if (control[i] >= 0)
+                {
+                    std::destroy_at(&slots[i]);
+                }
+            }
+        }
+
+        void release_storage() noexcept
+        {
+            if (slots)
+            {
+                destroy_slots();
+                SlotAllocatorTraits::deallocate(allocator, slots, control.size());
+                slots = nullptr;
+            }
+            control.clear();
+            real_size = 0ull;
+            deleted_count = 0ull;
+        }
+
+        // Moves every element into a table of `capacity` slots, which also drops all the tombstones.
+        void resize(const size_t capacity)
+        {
+            std::vector<int8_t> previous_control(capacity, EMPTY);
+            Slot* previous_slots = SlotAllocatorTraits::allocate(allocator, capacity);
+            std::swap(control, previous_control);
+            std::swap(slots, previous_slots);
+            deleted_count = 0ull;
+
+            for (size_t i = 0; i < previous_control.size(); ++i)
+            {
+                if (previous_control[i] >= 0)
+                {
+                    const size_t hash = get_hash(previous_slots[i].first);
+                    const size_t index = find_free_index(hash);
+                    std::construct_at(&slots[index], std::move(previous_slots[i]));
+                    control[index] = get_fragment(hash);
+                    std::destroy_at(&previous_slots[i]);
+                }
+            }
+
+            if (previous_slots)
+            {
+                SlotAllocatorTraits::deallocate(allocator, previous_slots, previous_control.size());
+            }
+        }
+
+        // Called when no free slot is left under the load limit. Mostly tombstones means cleaning them up in
+        // a table of the same size, otherwise the capacity doubles.
+        void grow()
+        {
+            if (control.empty())
+            {
+                resize(Group::width);
+            }
+            else if (real_size + 1 > get_growth_limit() / 2)
+            {
+                resize(control.size() * 2);
+            }
+            else
+            {
+                resize(control.size());
+            }
+        }
+
+    public:
+        friend void swap(HashMap& first, HashMap& second) noexcept
+        {
+            using std::swap;
+            swap(first.control, second.control);
+            swap(first.slots, second.slots);
+            swap(first.real_size, second.real_size);
+            swap(first.deleted_count, second.deleted_count);
+            swap(first.hasher, second.hasher);
+            swap(first.key_equal, second.key_equal);
+        }
+
+        HashMap() : HashMap(Hash_(), KeyEqual_())
+        {
+        }
+
+        explicit HashMap(const Hash_& hash, const KeyEqual_& equal = KeyEqual_()) : hasher(hash), key_equal(equal)
+        {
+        }
 
-            Bucket() = default;
-            Bucket(const Bucket& other)
+        HashMap(const HashMap& other) : HashMap(other.hasher, other.key_equal)
+        {
+            reserve(other.real_size);
+            for (const auto& [key, value] : other)
             {
-                for (auto& element: other.get_all_elements())
-                {
-                    insert(element.first, element.second);
-                }
+                insert(key, value);
             }
+        }
 
-            friend void swap(Bucket& first, Bucket& second) noexcept
-            {
-                using std::swap;
-                swap(first.pair_list, second.pair_list);
-            }
+        HashMap(HashMap&& other) noexcept : HashMap(other.hasher, other.key_equal)
+        {
+            swap(*this, other);
+        }
 
-            Bucket& operator=(Bucket other)
-            {
-                swap(*this,other);
-                return *this;
-            }
+        HashMap& operator=(HashMap other)
+        {
+            swap(*this, other);
+            return *this;
+        }
 
-            const std::list<Pair>& get_all_elements() const
-            {
-                return pair_list;
-            }
+        ~HashMap()
+        {
+            release_storage();
+        }
 
-            std::list<Pair>& get_all_elements()
+        // A key of another type than K is converted only when it is not in the map yet.
+        template<typename Key_ = K, typename Value_ = V>
+        void insert(Key_&& key, Value_&& value)
+        {
+            if constexpr (!is_lookup_key<Key_>)
             {
-                return pair_list;
+                insert(K(std::forward<Key_>(key)), std::forward<Value_>(value));
             }
-
-            std::optional<std::reference_wrapper<V>> get_at(const K& key)
+            else
             {
-                for (auto& element: pair_list)
+                if (const size_t index = find_index(key); index != npos)
                 {
-                    if (element.first == key)
-                    {
-                        return element.second;
-                    }
+                    slots[index].second = std::forward<Value_>(value);
+                    return;
                 }
-                return std::nullopt;
-            }
 
-            template<typename Key_ = K,typename Value_ = V>
-            void insert(Key_&& key, Value_&& value)
-            {
-                for (auto& element: pair_list)
+                if (real_size + deleted_count + 1 > get_growth_limit())
                 {
-                    if (element.first == key)
-                    {
-                        element.second = std::forward<Value_>(value);
-                        return;
-                    }
+                    grow();
                 }
-                pair_list.push_back(std::pair{std::forward<Key_>(key), std::forward<Value_>(value)});
-            }
 
-            void erase(const K& key)
-            {
-                pair_list.remove_if([&](const auto& element){return element.first == key;});
+                const size_t hash = get_hash(key);
+                const size_t index = find_free_index(hash);
+                std::construct_at(&slots[index], K(std::forward<Key_>(key)), std::forward<Value_>(value));
+                if (control[index] == DELETED)
+                {
+                    --deleted_count;
+                }
+                control[index] = get_fragment(hash);
+                ++real_size;
             }
+        }
+
+        void remove(const K& key)
+        {
+            remove<K>(key);
+        }
 
-            [[nodiscard]] bool is_empty() const noexcept
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        void remove(const Key_& key)
+        {
+            if (const size_t index = find_index(key); index != npos)
             {
-                return pair_list.empty();
+                erase_index(index);
             }
+        }
 
-        private:
-            std::list<Pair> pair_list;
+        V& find(const K& key)
+        {
+            return find<K>(key);
+        }
 
-        };
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        V& find(const Key_& key)
+        {
+            if (const size_t index = find_index(key); index != npos)
+            {
+                return slots[index].second;
+            }
+            throw std::out_of_range("Key doesn't exist");
+        }
 
-        std::vector<Bucket> m_map;
-        size_t real_size = 0ull;
+        bool contains(const K& key) const
+        {
+            return find_index(key) != npos;
+        }
 
-        size_t get_hash(const K& key)
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        bool contains(const Key_& key) const
         {
-            size_t hash_index = std::hash<K>{}(key);
-            hash_index %= m_map.size();
-            return hash_index;
+            return find_index(key) != npos;
         }
 
-        std::pair<K,V>& get_at_index(size_t index)
+        // Makes room for `count` elements without growing.
+        void reserve(const size_t count)
         {
-            if (index >= real_size)
+            size_t capacity = control.empty() ? Group::width : control.size();
+            while (capacity - capacity / 8 < count)
             {
-                throw std::out_of_range("Iterator out of range");
+                capacity *= 2;
             }
-
-            size_t id = 0ull;
-            for (auto & element: m_map)
+            if (capacity != control.size())
             {
-                if (!element.is_empty())
-                {
-                    for (auto& pair: element.get_all_elements())
-                    {
-                        if (id++ == index)
-                        {
-                            return pair;
-                        }
-                    }
-                }
+                resize(capacity);
             }
-
-            throw std::out_of_range("Iterator out of range");
         }
 
-    public:
-
-        HashMap()
+        void clear() noexcept
         {
-            m_map.resize(10);
+            destroy_slots();
+            std::fill(control.begin(), control.end(), EMPTY);
+            real_size = 0ull;
+            deleted_count = 0ull;
         }
 
-        template<typename Key_ = K, typename Value_ = V>
-        void insert(Key_&& key, Value_&& value)
+        size_t get_size() const noexcept
         {
-            m_map[get_hash(key)].insert(std::forward<Key_>(key), std::forward<Value_>(value));
-            ++real_size;
+            return real_size;
         }
 
-        V& find(const K& key)
+        size_t get_capacity() const noexcept
         {
-            auto result = m_map[get_hash(key)].get_at(key);
-            if (!result)
-            {
-                throw std::out_of_range("Key doesn't exist");
-            }
-            return *result;
+            return control.size();
         }
 
-        void remove(const K& key)
+        bool is_empty() const noexcept
         {
-            m_map[get_hash(key)].erase(key);
-            --real_size;
+            return real_size == 0ull;
         }
 
-        void rehash()
+        // Walks the control bytes in order and stops on full slots, a full iteration is O(capacity).
+        template<typename Type>
+        class Iterator
         {
-            real_size = 0ull;
-            auto previous = m_map;
+            friend class HashMap;
+            template<typename>
+            friend class Iterator;
+
+            using Map = std::conditional_t<std::is_const_v<Type>, const HashMap, HashMap>;
 
-            m_map.clear();
-            m_map.resize(previous.size() * 2);
+            Map* map = nullptr;
+            size_t index = 0ull;
+
+            Iterator(Map* map_, const size_t index_) : map(map_), index(index_)
+            {
+                skip_free_slots();
+            }
 
-            for (auto & bucket: previous)
+            void skip_free_slots()
             {
-                for (auto& element: bucket.get_all_elements())
+                while (index < map->control.size() && map->control[index] < 0)
                 {
-                    insert(std::move(element.first), std::move(element.second));
+                    ++index;
                 }
             }
-        }
-
-        friend class Iterator;
-
-        template<typename Type>
-        class Iterator : public std::iterator<std::bidirectional_iterator_tag, Type>
-        {
-            HashMap* map = nullptr;
-            size_t index = 0ull;
-
-            using Reference = Type&;
-            using Pointer = Type*;
         public:
-
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_cv_t<Type>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Type*;
+            using reference = Type&;
 
             Iterator() = default;
-            Iterator(HashMap* map_, const size_t index_) : map(map_), index(index_)
-            {}
 
-            Reference operator*()
+            // iterator converts to const_iterator.
+            template<typename Other>
+            requires (std::is_const_v<Type> && std::same_as<const Other, Type>)
+            Iterator(const Iterator<Other>& other) : map(other.map), index(other.index)
             {
-                return map->get_at_index(index);
             }
 
-            Pointer operator->()
+            reference operator*() const
             {
-                return &map->get_at_index(index);
+                return map->slots[index];
             }
 
-            bool operator==(const Iterator & other) const
+            pointer operator->() const
             {
-                return other.map == map && index == other.index;
+                return &map->slots[index];
             }
 
-            bool operator!=(const Iterator & other) const
+            bool operator==(const Iterator & other) const
             {
-                return !(other == *this);
+                return other.map == map && index == other.index;
             }
 
-            bool operator<=>(const Iterator& other) const = default;
-
             Iterator& operator++()
             {
                 ++index;
+                skip_free_slots();
                 return *this;
             }
 
@@ -229,229 +1614,422 @@ namespace ClosedHashMap
             }
         };
 
+        using iterator = Iterator<std::pair<K,V>>;
+        using const_iterator = Iterator<const std::pair<K,V>>;
+
+        // Removes the element at `position` and returns the position of the following one.
+        iterator erase(const_iterator position)
+        {
+            erase_index(position.index);
+            return iterator(this, position.index + 1);
+        }
+
+        iterator begin()
+        {
+            return iterator(this, 0ull);
+        }
+
+        iterator end()
+        {
+            return iterator(this, control.size());
+        }
 
-        Iterator<std::pair<K,V>> begin()
+        const_iterator begin() const
         {
-            return Iterator<std::pair<K,V>>(this, 0);
+            return const_iterator(this, 0ull);
         }
 
-        Iterator<std::pair<K,V>> end()
+        const_iterator end() const
         {
-            return Iterator<std::pair<K,V>>(this, real_size);
+            return const_iterator(this, control.size());
         }
     };
 }
 
 
-namespace OpenHashMap
+// Linear probing where every slot records how far it sits from its home slot. An insertion takes the slot
+// of any element closer to home than itself and carries that element on, which keeps probe lengths even.
+// A lookup stops as soon as it meets an element closer to home than the key would be, and a removal
+// shifts the following elements one slot back, so churn never leaves tombstones behind.
+namespace RobinHoodHashMap
 {
-    template<typename K, typename V>
+    // Hash_ and KeyEqual_ may be transparent (see HashMapPolicy::StringHash) to look keys up from other types.
+    // The capacity is a power of two and the table grows past its max load factor.
+    template<typename K, typename V, typename Hash_ = std::hash<K>, typename KeyEqual_ = std::equal_to<K>>
     class HashMap
     {
-        enum class State {EMPTY, OCCUPIED, TRASH};
+        template<typename Key_>
+        static constexpr bool is_lookup_key = std::same_as<std::remove_cvref_t<Key_>, K> ||
+                                              HashMapPolicy::Transparent<Hash_, KeyEqual_>;
 
-        struct Cell
-        {
-            State state = State::EMPTY;
-            std::pair<K,V> pair;
-        };
+        using Slot = std::pair<K,V>;
+        using SlotAllocator = std::allocator<Slot>;
+        using SlotAllocatorTraits = std::allocator_traits<SlotAllocator>;
 
-        std::vector<Cell> m_map;
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+        static constexpr size_t initial_capacity = 16ull;
+
+        // Probe distance plus one of each slot, 0 for an empty slot.
+        std::vector<uint32_t> distances;
+        Slot* slots = nullptr;
         size_t real_size = 0ull;
+        float max_load_factor = 0.875f;
+
+        [[no_unique_address]] SlotAllocator allocator;
+        [[no_unique_address]] Hash_ hasher;
+        [[no_unique_address]] KeyEqual_ key_equal;
 
-        size_t get_hash(const K& key)
+        template<typename Key_>
+        size_t get_home(const Key_& key) const
         {
-            size_t hash_index = std::hash<K>{}(key);
-            hash_index %= m_map.size();
-            return hash_index;
+            return HashMapPolicy::PowerOfTwoIndexing::mix(hasher(key)) & (distances.size() - 1);
         }
 
-        template<typename Key_ = K, typename Value_ = V>
-        void insert_at(size_t index, Key_&& key, Value_&& value)
+        size_t get_next(const size_t index) const noexcept
         {
-            if (real_size == m_map.size())
-            {
-                rehash();
-                insert(std::forward<K>(key), std::forward<V>(value));
-                return;
-            }
+            return (index + 1) & (distances.size() - 1);
+        }
 
-            if (index >= m_map.size())
+        template<typename Key_>
+        size_t find_index(const Key_& key) const
+        {
+            if (real_size == 0ull)
             {
-                insert_at(0, std::forward<Key_>(key), std::forward<Value_>(value));
-                return;
+                return npos;
             }
 
-            if (m_map[index].state == State::EMPTY || m_map[index].state == State::TRASH)
-            {
-                m_map[index].state = State::OCCUPIED;
-                m_map[index].pair.first = std::forward<Key_>(key);
-                m_map[index].pair.second = std::forward<Value_>(value);
-                ++real_size;
-                return;
-            }
-            else
+            size_t index = get_home(key);
+            for (uint32_t distance = 1; distance <= distances[index]; ++distance)
             {
-                insert_at(index + 1, std::forward<Key_>(key), std::forward<Value_>(value));
+                if (distance == distances[index] && key_equal(slots[index].first, key))
+                {
+                    return index;
+                }
+                index = get_next(index);
             }
+            return npos;
         }
 
-        void rehash()
+        // Places `slot`, which is not in the map yet, displacing richer elements along the way.
+        void place(Slot&& slot)
         {
-            real_size = 0;
-            auto previous = m_map;
-            m_map.clear();
-            m_map.resize(previous.size() * 2);
-
-            for (auto& element: previous)
+            size_t index = get_home(slot.first);
+            uint32_t distance = 1;
+            while (distances[index] != 0)
             {
-                insert(std::move(element.pair.first), std::move(element.pair.second));
+                if (distances[index] < distance)
+                {
+                    using std::swap;
+                    swap(slot, slots[index]);
+                    swap(distance, distances[index]);
+                }
+                index = get_next(index);
+                ++distance;
             }
+            std::construct_at(&slots[index], std::move(slot));
+            distances[index] = distance;
         }
 
-        std::pair<K,V>& get_at_index(size_t index)
+        // Moves the following elements back until one is already at home or the next slot is empty.
+        // Returns the slot left empty at the end, which is below `index` when the shift wrapped around.
+        size_t erase_index(size_t index)
         {
-            if (index >= real_size)
+            std::destroy_at(&slots[index]);
+            for (size_t next = get_next(index); distances[next] > 1; next = get_next(next))
             {
-                throw std::out_of_range("Iterator out of range");
+                std::construct_at(&slots[index], std::move(slots[next]));
+                std::destroy_at(&slots[next]);
+                distances[index] = distances[next] - 1;
+                index = next;
             }
+            distances[index] = 0;
+            --real_size;
+            return index;
+        }
 
-            size_t id = 0ull;
-            for (auto & element: m_map)
+        void destroy_slots() noexcept
+        {
+            for (size_t i = 0; i < distances.size(); ++i)
             {
-                if (element.state == State::OCCUPIED)
+                if (distances[i] != 0)
                 {
-                    if (index == id++)
-                    {
-                        return element.pair;
-                    }
+                    std::destroy_at(&slots[i]);
                 }
             }
-
-            throw std::out_of_range("Iterator out of range");
         }
 
-        std::optional<std::reference_wrapper<Cell>> try_find(const K& key)
+        void release_storage() noexcept
         {
-            int index = get_hash(key);
-            for (size_t i = 0; i < m_map.size(); ++i)
+            if (slots)
             {
-                index = index + i > m_map.size() ? index + i % m_map.size() : index + i;
+                destroy_slots();
+                SlotAllocatorTraits::deallocate(allocator, slots, distances.size());
+                slots = nullptr;
+            }
+            distances.clear();
+            real_size = 0ull;
+        }
+
+        void resize(const size_t capacity)
+        {
+            std::vector<uint32_t> previous_distances(capacity, 0u);
+            Slot* previous_slots = SlotAllocatorTraits::allocate(allocator, capacity);
+            std::swap(distances, previous_distances);
+            std::swap(slots, previous_slots);
 
-                if (m_map[i].pair.first == key)
+            for (size_t i = 0; i < previous_distances.size(); ++i)
+            {
+                if (previous_distances[i] != 0)
                 {
-                    if(m_map[i].state == State::OCCUPIED && m_map[i].pair.first == key)
-                    {
-                        return m_map[i];
-                    }
+                    place(std::move(previous_slots[i]));
+                    std::destroy_at(&previous_slots[i]);
                 }
             }
-            return std::nullopt;
+
+            if (previous_slots)
+            {
+                SlotAllocatorTraits::deallocate(allocator, previous_slots, previous_distances.size());
+            }
+        }
+
+        bool exceeds_load(const size_t count, const size_t capacity) const noexcept
+        {
+            return static_cast<float>(count) > max_load_factor * static_cast<float>(capacity);
         }
+
     public:
         friend void swap(HashMap& first, HashMap& second) noexcept
         {
             using std::swap;
-            swap(first.m_map, second.m_map);
+            swap(first.distances, second.distances);
+            swap(first.slots, second.slots);
             swap(first.real_size, second.real_size);
+            swap(first.max_load_factor, second.max_load_factor);
+            swap(first.hasher, second.hasher);
+            swap(first.key_equal, second.key_equal);
+        }
+
+        HashMap() : HashMap(Hash_(), KeyEqual_())
+        {
         }
 
-        HashMap() : m_map(10)
-        {}
+        explicit HashMap(const Hash_& hash, const KeyEqual_& equal = KeyEqual_()) : hasher(hash), key_equal(equal)
+        {
+        }
 
-        HashMap(const HashMap& other)
+        HashMap(const HashMap& other) : HashMap(other.hasher, other.key_equal)
         {
-            for (auto& element: other.m_map)
+            max_load_factor = other.max_load_factor;
+            reserve(other.real_size);
+            for (const auto& [key, value] : other)
             {
-                insert(element.pair.first, element.pair.second);
+                insert(key, value);
             }
         }
 
+        HashMap(HashMap&& other) noexcept : HashMap(other.hasher, other.key_equal)
+        {
+            swap(*this, other);
+        }
+
         HashMap& operator=(HashMap other)
         {
             swap(*this, other);
             return *this;
         }
 
-        template<typename Key_ = K,typename Value_ = V>
+        ~HashMap()
+        {
+            release_storage();
+        }
+
+        // A key of another type than K is converted only when it is not in the map yet.
+        template<typename Key_ = K, typename Value_ = V>
         void insert(Key_&& key, Value_&& value)
         {
-            if (auto cell = try_find(key))
+            if constexpr (!is_lookup_key<Key_>)
             {
-                cell->get().pair.second = std::forward<V>(value);
-                return;
+                insert(K(std::forward<Key_>(key)), std::forward<Value_>(value));
+            }
+            else
+            {
+                if (const size_t index = find_index(key); index != npos)
+                {
+                    slots[index].second = std::forward<Value_>(value);
+                    return;
+                }
+
+                reserve(real_size + 1);
+                place(Slot(K(std::forward<Key_>(key)), std::forward<Value_>(value)));
+                ++real_size;
             }
-            size_t index = get_hash(key);
-            insert_at(index, std::forward<Key_>(key), std::forward<Value_>(value));
         }
 
         void remove(const K& key)
         {
-            for (size_t i = get_hash(key); i < m_map.size(); ++i)
+            remove<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        void remove(const Key_& key)
+        {
+            if (const size_t index = find_index(key); index != npos)
             {
-                if (m_map[i].pair.first == key)
-                {
-                    if(m_map[i].state == State::OCCUPIED && m_map[i].pair.first == key)
-                    {
-                        --real_size;
-                        m_map[i].state = State::TRASH;
-                        return;
-                    }
-                }
+                erase_index(index);
             }
         }
 
         V& find(const K& key)
         {
-            if (auto cell = try_find(key))
+            return find<K>(key);
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        V& find(const Key_& key)
+        {
+            if (const size_t index = find_index(key); index != npos)
             {
-                return cell->get().pair.second;
+                return slots[index].second;
             }
             throw std::out_of_range("Key doesn't exist");
         }
 
-        friend class Iterator;
+        bool contains(const K& key) const
+        {
+            return find_index(key) != npos;
+        }
+
+        template<typename Key_>
+        requires is_lookup_key<Key_>
+        bool contains(const Key_& key) const
+        {
+            return find_index(key) != npos;
+        }
+
+        // Makes room for `count` elements without growing.
+        void reserve(const size_t count)
+        {
+            size_t capacity = distances.empty() ? initial_capacity : distances.size();
+            while (exceeds_load(count, capacity))
+            {
+                capacity *= 2;
+            }
+            if (capacity != distances.size())
+            {
+                resize(capacity);
+            }
+        }
+
+        void clear() noexcept
+        {
+            destroy_slots();
+            std::fill(distances.begin(), distances.end(), 0u);
+            real_size = 0ull;
+        }
+
+        size_t get_size() const noexcept
+        {
+            return real_size;
+        }
+
+        size_t get_capacity() const noexcept
+        {
+            return distances.size();
+        }
+
+        bool is_empty() const noexcept
+        {
+            return real_size == 0ull;
+        }
+
+        [[nodiscard]] float get_load_factor() const noexcept
+        {
+            return distances.empty() ? 0.f : static_cast<float>(real_size) / static_cast<float>(distances.size());
+        }
+
+        // Must lie in (0, 1), takes effect on the next insertion.
+        void set_max_load_factor(const float load_factor)
+        {
+            if (load_factor <= 0.f || load_factor >= 1.f)
+            {
+                throw std::invalid_argument("max load factor must be between 0 and 1");
+            }
+            max_load_factor = load_factor;
+        }
 
+        // Walks the slots in order and stops on full ones, a full iteration is O(capacity).
         template<typename Type>
-        class Iterator : public std::iterator<std::bidirectional_iterator_tag, Type>
+        class Iterator
         {
-            HashMap* map = nullptr;
+            friend class HashMap;
+            template<typename>
+            friend class Iterator;
+
+            using Map = std::conditional_t<std::is_const_v<Type>, const HashMap, HashMap>;
+
+            Map* map = nullptr;
             size_t index = 0ull;
+            // Slots from `limit` on hold elements that erase shifted back from the start of the table,
+            // which the iteration already went through.
+            size_t limit = 0ull;
 
-            using Reference = Type&;
-            using Pointer = Type*;
-        public:
+            Iterator(Map* map_, const size_t index_) : Iterator(map_, index_, map_->distances.size())
+            {
+            }
+
+            Iterator(Map* map_, const size_t index_, const size_t limit_) : map(map_), index(index_), limit(limit_)
+            {
+                skip_free_slots();
+            }
 
+            void skip_free_slots()
+            {
+                while (index < limit && map->distances[index] == 0)
+                {
+                    ++index;
+                }
+                if (index >= limit)
+                {
+                    index = map->distances.size();
+                }
+            }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_cv_t<Type>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Type*;
+            using reference = Type&;
 
             Iterator() = default;
-            Iterator(HashMap* map_, const size_t index_) : map(map_), index(index_)
-            {}
 
-            Reference operator*()
+            // iterator converts to const_iterator.
+            template<typename Other>
+            requires (std::is_const_v<Type> && std::same_as<const Other, Type>)
+            Iterator(const Iterator<Other>& other) : map(other.map), index(other.index), limit(other.limit)
             {
-                return map->get_at_index(index);
             }
 
-            Pointer operator->()
+            reference operator*() const
             {
-                return &map->get_at_index(index);
+                return map->slots[index];
             }
 
-            bool operator==(const Iterator & other) const
+            pointer operator->() const
             {
-                return other.map == map && index == other.index;
+                return &map->slots[index];
             }
 
-            bool operator!=(const Iterator & other) const
+            bool operator==(const Iterator & other) const
             {
-                return !(other == *this);
+                return other.map == map && index == other.index;
             }
 
-            bool operator<=>(const Iterator& other) const = default;
-
             Iterator& operator++()
             {
                 ++index;
+                skip_free_slots();
                 return *this;
             }
 
@@ -463,15 +2041,41 @@ namespace OpenHashMap
             }
         };
 
-        Iterator<std::pair<K,V>> begin()
+        using iterator = Iterator<std::pair<K,V>>;
+        using const_iterator = Iterator<const std::pair<K,V>>;
+
+        // Removes the element at `position` and returns the position of the following one. The backward shift
+        // moves the next elements into `position` itself, and when it wraps around it also brings the elements
+        // at the start of the table, already visited, to its end. The returned iterator stops before those.
+        iterator erase(const_iterator position)
+        {
+            const size_t emptied = erase_index(position.index);
+            size_t limit = position.limit;
+            if (emptied < position.index || emptied >= limit)
+            {
+                --limit;
+            }
+            return iterator(this, position.index, limit);
+        }
+
+        iterator begin()
+        {
+            return iterator(this, 0ull);
+        }
+
+        iterator end()
         {
-            return Iterator<std::pair<K,V>>(this,0);
+            return iterator(this, distances.size());
         }
 
-        Iterator<std::pair<K,V>> end()
+        const_iterator begin() const
         {
-            return Iterator<std::pair<K,V>>(this,real_size);
+            return const_iterator(this, 0ull);
         }
 
+        const_iterator end() const
+        {
+            return const_iterator(this, distances.size());
+        }
     };
-}
\ No newline at end of file
+}
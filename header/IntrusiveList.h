@@ -0,0 +1,351 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+template<typename T, typename Tag_>
+class IntrusiveList;
+
+// Link field embedded in the objects of an IntrusiveList, as a public base class. An object can be in as many
+// lists as it has hooks, each hook base told apart by its Tag_. Copying an object does not copy its memberships,
+// and destroying it unlinks it.
+template<typename Tag_ = void>
+class IntrusiveListHook
+{
+    template<typename T, typename>
+    friend class IntrusiveList;
+
+    IntrusiveListHook* next = nullptr;
+    IntrusiveListHook* prev = nullptr;
+
+    void link_before(IntrusiveListHook* position) noexcept
+    {
+        next = position;
+        prev = position->prev;
+        prev->next = this;
+        position->prev = this;
+    }
+
+public:
+    IntrusiveListHook() = default;
+
+    IntrusiveListHook(const IntrusiveListHook&) noexcept
+    {
+    }
+
+    IntrusiveListHook& operator=(const IntrusiveListHook&) noexcept
+    {
+        return *this;
+    }
+
+    ~IntrusiveListHook()
+    {
+        unlink();
+    }
+
+    [[nodiscard]] bool is_linked() const noexcept
+    {
+        return next != nullptr;
+    }
+
+    // Removes the owner from its list in O(1), without knowing which list it is.
+    void unlink() noexcept
+    {
+        if (next)
+        {
+            prev->next = next;
+            next->prev = prev;
+            next = nullptr;
+            prev = nullptr;
+        }
+    }
+};
+
+// Doubly-linked list threading objects through their IntrusiveListHook<Tag_> base.
+// The list neither allocates nor owns its elements: linking and unlinking only rewrite hook pointers.
+// Since elements can unlink themselves, the size is not cached and get_size() is O(n).
+template<typename T, typename Tag_ = void>
+class IntrusiveList
+{
+    using Hook = IntrusiveListHook<Tag_>;
+
+    // Circular sentinel, root.next is the first element and root.prev the last. It is the only hook
+    // in the list that is not the base of a T, and owner_of is never called on it.
+    Hook root;
+
+    static Hook& hook_of(T& element) noexcept
+    {
+        static_assert(std::derived_from<T, Hook>, "T must publicly derive from IntrusiveListHook<Tag_>");
+        return static_cast<Hook&>(element);
+    }
+
+    static T& owner_of(Hook* hook) noexcept
+    {
+        return static_cast<T&>(*hook);
+    }
+
+    void make_empty() noexcept
+    {
+        root.next = &root;
+        root.prev = &root;
+    }
+
+    void take_elements_from(IntrusiveList& other) noexcept
+    {
+        if (other.is_empty())
+        {
+            make_empty();
+            return;
+        }
+
+        root.next = other.root.next;
+        root.prev = other.root.prev;
+        root.next->prev = &root;
+        root.prev->next = &root;
+        other.make_empty();
+    }
+
+    template<typename U>
+    class Iterator
+    {
+        friend class IntrusiveList;
+        template<typename>
+        friend class Iterator;
+
+        Hook* hook = nullptr;
+
+        explicit Iterator(Hook* hook_) : hook(hook_)
+        {
+        }
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::remove_cv_t<U>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        Iterator() = default;
+
+        // iterator converts to const_iterator.
+        template<typename V>
+        requires (std::is_const_v<U> && std::same_as<const V, U>)
+        Iterator(const Iterator<V>& other) : hook(other.hook)
+        {
+        }
+
+        U& operator*() const
+        {
+            return owner_of(hook);
+        }
+
+        U* operator->() const
+        {
+            return &owner_of(hook);
+        }
+
+        bool operator==(const Iterator & other) const
+        {
+            return hook == other.hook;
+        }
+
+        Iterator& operator++()
+        {
+            hook = hook->next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        Iterator& operator--()
+        {
+            hook = hook->prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+    };
+
+public:
+    using value_type = T;
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    IntrusiveList() noexcept
+    {
+        make_empty();
+    }
+
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    IntrusiveList(IntrusiveList&& other) noexcept
+    {
+        take_elements_from(other);
+    }
+
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            take_elements_from(other);
+        }
+        return *this;
+    }
+
+    // Unlinks the elements, they are not destroyed.
+    ~IntrusiveList()
+    {
+        clear();
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return root.next == &root;
+    }
+
+    [[nodiscard]] size_t get_size() const noexcept
+    {
+        size_t size = 0ull;
+        for (auto it = root.next; it != &root; it = it->next)
+        {
+            ++size;
+        }
+        return size;
+    }
+
+    // An element already linked through this hook is first unlinked from its current list,
+    // so moving an object between two lists is a single call.
+    void push_back(T& element) noexcept
+    {
+        insert(end(), element);
+    }
+
+    void push_front(T& element) noexcept
+    {
+        insert(begin(), element);
+    }
+
+    // Links `element` before `position`.
+    iterator insert(const_iterator position, T& element) noexcept
+    {
+        Hook& hook = hook_of(element);
+        hook.unlink();
+        hook.link_before(position.hook);
+        return iterator(&hook);
+    }
+
+    // Returns the iterator following the unlinked element.
+    iterator erase(const_iterator position) noexcept
+    {
+        Hook* next = position.hook->next;
+        position.hook->unlink();
+        return iterator(next);
+    }
+
+    // Unlinks `element` from whichever list it is in, through this list's hook.
+    static void remove(T& element) noexcept
+    {
+        hook_of(element).unlink();
+    }
+
+    [[nodiscard]] static bool is_linked(const T& element) noexcept
+    {
+        static_assert(std::derived_from<T, Hook>, "T must publicly derive from IntrusiveListHook<Tag_>");
+        return static_cast<const Hook&>(element).is_linked();
+    }
+
+    // Iterator to an element known to be in this list.
+    static iterator iterator_to(T& element) noexcept
+    {
+        return iterator(&hook_of(element));
+    }
+
+    T& front() noexcept
+    {
+        return owner_of(root.next);
+    }
+
+    T& back() noexcept
+    {
+        return owner_of(root.prev);
+    }
+
+    void pop_front() noexcept
+    {
+        if (!is_empty())
+        {
+            root.next->unlink();
+        }
+    }
+
+    void pop_back() noexcept
+    {
+        if (!is_empty())
+        {
+            root.prev->unlink();
+        }
+    }
+
+    // Moves every element of `other` to the end of this list in O(1).
+    void splice_back(IntrusiveList& other) noexcept
+    {
+        if (&other == this || other.is_empty())
+            return;
+
+        Hook* first = other.root.next;
+        Hook* last = other.root.prev;
+
+        first->prev = root.prev;
+        root.prev->next = first;
+        last->next = &root;
+        root.prev = last;
+
+        other.make_empty();
+    }
+
+    void clear() noexcept
+    {
+        while (!is_empty())
+        {
+            root.next->unlink();
+        }
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(root.next);
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(&root);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(root.next);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(const_cast<Hook*>(&root));
+    }
+};
@@ -3,57 +3,220 @@
 //
 
 #pragma once
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 #include <iostream>
 
-template<typename T>
+// Linked list with a cursor. Singly linked by default, DoublyLinked_ adds a back link
+// to every node for bidirectional iteration and O(1) pop_back.
+template<typename T, bool DoublyLinked_ = false>
 class List
 {
+    struct NoLink
+    {
+    };
 
     struct Node
     {
         T data;
-        Node* next;
+        Node* next = nullptr;
+        [[no_unique_address]] std::conditional_t<DoublyLinked_, Node*, NoLink> prev{};
 
         ~Node() = default;
     };
 
     Node* head = nullptr;
+    Node* tail = nullptr;
     Node* cursor = nullptr;
+    // Node preceding the cursor, kept so that erasing at the cursor is O(1) in both modes.
+    Node* before_cursor = nullptr;
     size_t size = 0ull;
 
-    Node* get_last_node()
+    static void set_prev(Node* node, Node* prev) noexcept
     {
-        if (!head)
-            return nullptr;
+        if constexpr (DoublyLinked_)
+        {
+            if (node)
+            {
+                node->prev = prev;
+            }
+        }
+    }
 
-        auto it = head;
-        while (it->next)
+    // Links `node` after `previous`, or in front of the list when `previous` is null.
+    void link_after(Node* previous, Node* node) noexcept
+    {
+        Node* next = previous ? previous->next : head;
+        node->next = next;
+        set_prev(node, previous);
+        set_prev(next, node);
+
+        if (previous)
         {
-            it = it->next;
+            previous->next = node;
+        }
+        else
+        {
+            head = node;
+        }
+
+        if (previous == tail)
+        {
+            tail = node;
+        }
+        if (next == cursor && cursor)
+        {
+            before_cursor = node;
+        }
+        ++size;
+    }
+
+    // Moves the whole chain of `other` after `previous`, or in front of the list when `previous` is null.
+    void splice_after(Node* previous, List& other) noexcept
+    {
+        if (&other == this || !other.head)
+            return;
+
+        Node* first = other.head;
+        Node* last = other.tail;
+        Node* next = previous ? previous->next : head;
+
+        last->next = next;
+        set_prev(first, previous);
+        set_prev(next, last);
+
+        if (previous)
+        {
+            previous->next = first;
+        }
+        else
+        {
+            head = first;
+        }
+
+        if (previous == tail)
+        {
+            tail = last;
+        }
+        if (next == cursor && cursor)
+        {
+            before_cursor = last;
         }
-        return it;
+        size += other.size;
+
+        other.head = other.tail = other.cursor = other.before_cursor = nullptr;
+        other.size = 0ull;
     }
 
+    template<typename U>
+    class Iterator
+    {
+        friend class List;
+        template<typename>
+        friend class Iterator;
+
+        using Owner = std::conditional_t<std::is_const_v<U>, const List, List>;
+
+        Node* node = nullptr;
+        Owner* list = nullptr;
+
+        Iterator(Node* node_, Owner* list_) : node(node_), list(list_)
+        {
+        }
+    public:
+        using iterator_category = std::conditional_t<DoublyLinked_, std::bidirectional_iterator_tag, std::forward_iterator_tag>;
+        using value_type = std::remove_cv_t<U>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        Iterator() = default;
+
+        // iterator converts to const_iterator.
+        template<typename V>
+        requires (std::is_const_v<U> && std::same_as<const V, U>)
+        Iterator(const Iterator<V>& other) : node(other.node), list(other.list)
+        {
+        }
+
+        U& operator*() const
+        {
+            return node->data;
+        }
+
+        U* operator->() const
+        {
+            return &node->data;
+        }
+
+        bool operator==(const Iterator & other) const
+        {
+            return node == other.node;
+        }
+
+        Iterator& operator++()
+        {
+            node = node->next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        Iterator& operator--() requires DoublyLinked_
+        {
+            node = node ? node->prev : list->tail;
+            return *this;
+        }
+
+        Iterator operator--(int) requires DoublyLinked_
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+    };
+
 public:
+    using value_type = T;
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
     List() = default;
     List(const List& other)
     {
-        if (!other.head)
-            return;
-
         auto it = other.head;
         while (it)
         {
+            Node* previous = tail;
             push_back(it->data);
-            it = it->next;
             if (other.cursor == it)
             {
-                cursor = get_last_node();
+                cursor = tail;
+                before_cursor = previous;
             }
+            it = it->next;
+        }
+
+        if (!other.cursor)
+        {
+            cursor = nullptr;
+            before_cursor = nullptr;
         }
     }
 
+    List(List&& other) noexcept
+    {
+        swap(*this, other);
+    }
+
     List& operator=(List other)
     {
         swap(*this,other);
@@ -70,30 +233,114 @@ public:
         using std::swap;
         std::swap(first.size,second.size);
         std::swap(first.head,second.head);
+        std::swap(first.tail,second.tail);
         std::swap(first.cursor,second.cursor);
+        std::swap(first.before_cursor,second.before_cursor);
+    }
+
+    [[nodiscard]] size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return size == 0ull;
     }
 
     template<typename U = T>
     T* push_back(U&& element)
     {
         auto new_node = new Node({.data = (std::forward<U>(element)), .next = nullptr});
-        size++;
-        if (!head)
+        const bool was_empty = !head;
+        link_after(tail, new_node);
+
+        if (was_empty)
         {
-            head = new_node;
             cursor = new_node;
-            return &head->data;
+            before_cursor = nullptr;
         }
 
-        get_last_node()->next = new_node;
+        return &new_node->data;
+    }
+
+    template<typename U = T>
+    T* push_front(U&& element)
+    {
+        auto new_node = new Node({.data = (std::forward<U>(element)), .next = nullptr});
+        const bool was_empty = !head;
+        link_after(nullptr, new_node);
+
+        if (was_empty)
+        {
+            cursor = new_node;
+            before_cursor = nullptr;
+        }
 
         return &new_node->data;
     }
 
+    void pop_front()
+    {
+        if (!head)
+            return;
+
+        if (cursor == head)
+        {
+            cursor = head->next;
+        }
+        if (before_cursor == head)
+        {
+            before_cursor = nullptr;
+        }
+
+        Node* old_head = head;
+        head = head->next;
+        set_prev(head, nullptr);
+        if (!head)
+        {
+            tail = nullptr;
+        }
+
+        delete old_head;
+        --size;
+    }
+
+    void pop_back() requires DoublyLinked_
+    {
+        if (!tail)
+            return;
+
+        Node* old_tail = tail;
+        tail = tail->prev;
+        if (tail)
+        {
+            tail->next = nullptr;
+        }
+        else
+        {
+            head = nullptr;
+        }
+
+        if (cursor == old_tail)
+        {
+            cursor = nullptr;
+            before_cursor = nullptr;
+        }
+        else if (before_cursor == old_tail)
+        {
+            before_cursor = tail;
+        }
+
+        delete old_tail;
+        --size;
+    }
+
     void move_forward_cursor()
     {
         if (cursor && cursor->next)
         {
+            before_cursor = cursor;
             cursor = cursor->next;
         }
         else if (!cursor)
@@ -102,9 +349,24 @@ public:
         }
     }
 
+    void move_backward_cursor() requires DoublyLinked_
+    {
+        if (before_cursor)
+        {
+            cursor = before_cursor;
+            before_cursor = cursor->prev;
+        }
+    }
+
     void reset_cursor()
     {
         cursor = head;
+        before_cursor = nullptr;
+    }
+
+    T* get_cursor()
+    {
+        return cursor ? &cursor->data : nullptr;
     }
 
     T* insert_after_cursor(T element)
@@ -113,19 +375,124 @@ public:
             return nullptr;
 
         auto new_node = new Node({.data = (std::move(element)), .next = nullptr});
+        link_after(cursor, new_node);
+
+        return &new_node->data;
+    }
+
+    // Removes the element under the cursor, the cursor moves to the next element
+    // (or past the end when it was the last one). Returns false when there is no cursor.
+    bool erase_at_cursor()
+    {
+        if (!cursor)
+            return false;
+
+        Node* erased = cursor;
+        Node* next = erased->next;
 
-        if (cursor->next)
+        if (before_cursor)
         {
-            new_node->next = cursor->next;
-            cursor->next = new_node;
+            before_cursor->next = next;
         }
         else
         {
-            cursor->next = new_node;
+            head = next;
         }
-        size++;
+        set_prev(next, before_cursor);
 
-        return &new_node->data;
+        if (erased == tail)
+        {
+            tail = before_cursor;
+        }
+
+        cursor = next;
+        delete erased;
+        --size;
+        return true;
+    }
+
+    // Moves every element of `other` to the end of this list in O(1), `other` is left empty.
+    void splice_back(List& other) noexcept
+    {
+        splice_after(tail, other);
+    }
+
+    // Moves every element of `other` to the front of this list in O(1), `other` is left empty.
+    void splice_front(List& other) noexcept
+    {
+        splice_after(nullptr, other);
+    }
+
+    // Moves every element of `other` right after the cursor in O(1), `other` is left empty.
+    void splice_after_cursor(List& other) noexcept
+    {
+        if (cursor)
+        {
+            splice_after(cursor, other);
+        }
+    }
+
+    // Merges the sorted list `other` into this sorted list by relinking nodes, nothing is
+    // allocated or copied. Equal elements of this list come first. `other` is left empty.
+    template<typename Compare = std::less<>>
+    void merge(List& other, Compare compare = Compare())
+    {
+        if (&other == this || !other.head)
+            return;
+
+        Node* first = head;
+        Node* second = other.head;
+        Node* merged_tail = nullptr;
+        Node* merged_before_cursor = nullptr;
+
+        auto append = [&](Node* node)
+        {
+            if (node == cursor)
+            {
+                merged_before_cursor = merged_tail;
+            }
+            set_prev(node, merged_tail);
+            if (merged_tail)
+            {
+                merged_tail->next = node;
+            }
+            else
+            {
+                head = node;
+            }
+            merged_tail = node;
+        };
+
+        while (first && second)
+        {
+            if (compare(second->data, first->data))
+            {
+                Node* next = second->next;
+                append(second);
+                second = next;
+            }
+            else
+            {
+                Node* next = first->next;
+                append(first);
+                first = next;
+            }
+        }
+
+        for (Node* rest = first ? first : second; rest;)
+        {
+            Node* next = rest->next;
+            append(rest);
+            rest = next;
+        }
+
+        merged_tail->next = nullptr;
+        tail = merged_tail;
+        before_cursor = merged_before_cursor;
+        size += other.size;
+
+        other.head = other.tail = other.cursor = other.before_cursor = nullptr;
+        other.size = 0ull;
     }
 
     void print_list(const std::string& list_name = "")
@@ -155,6 +522,29 @@ public:
         }
 
         head = nullptr;
+        tail = nullptr;
         cursor = nullptr;
+        before_cursor = nullptr;
+        size = 0ull;
+    }
+
+    iterator begin()
+    {
+        return iterator(head, this);
+    }
+
+    iterator end()
+    {
+        return iterator(nullptr, this);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(head, this);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr, this);
     }
 };
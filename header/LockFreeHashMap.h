@@ -0,0 +1,427 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "HashMap.h"
+
+// Lock-free open addressing map for integral keys and values, meant for counters and id indexes shared by
+// many threads. A cell is an atomic key plus the index of an atomic value in a separate value store that
+// never moves, so once a key is in, updating it is a single fetch_add or store on its value. Keys are claimed
+// with a CAS on an empty cell and are never removed.
+//
+// When a table passes 3/4 load a table twice as large is chained after it, and every writer migrates a chunk
+// of cells before its own operation. Migrating a cell copies its key and value index to the next table, or
+// turns an empty cell into a moved marker, so keys are never lost to a writer racing the migration. Lookups
+// follow the chain on a moved marker and never wait on anyone. The root moves to the next table once every
+// chunk is migrated. Retired tables are kept until the map is destroyed, since readers may still be in them,
+// which at most doubles the memory of the cells.
+//
+// The two largest key values are reserved for the empty and moved markers.
+template<std::integral K = uint64_t, std::integral V = uint64_t>
+class LockFreeHashMap
+{
+    static constexpr size_t cache_line_size = 64ull;
+    static constexpr size_t migration_chunk_size = 1024ull;
+    static constexpr size_t unpublished = std::numeric_limits<size_t>::max();
+
+public:
+    static constexpr K empty_key = std::numeric_limits<K>::max();
+    static constexpr K moved_key = std::numeric_limits<K>::max() - 1;
+
+private:
+    struct Cell
+    {
+        std::atomic<K> key = empty_key;
+        // Written once by the thread that claimed the key, right after the claim.
+        std::atomic<size_t> slot = unpublished;
+    };
+
+    struct Table
+    {
+        const size_t capacity;
+        const size_t chunk_count;
+        std::unique_ptr<Cell[]> cells;
+
+        // Keys claimed in this table, plus the keys of the previous table when it was chained.
+        alignas(cache_line_size) std::atomic<size_t> load;
+        alignas(cache_line_size) std::atomic<Table*> next = nullptr;
+        std::atomic<size_t> migration_cursor = 0ull;
+        std::atomic<size_t> migrated_chunks = 0ull;
+
+        Table(const size_t capacity_, const size_t load_) :
+            capacity(capacity_),
+            chunk_count((capacity_ + migration_chunk_size - 1) / migration_chunk_size),
+            cells(std::make_unique<Cell[]>(capacity_)),
+            load(load_)
+        {
+        }
+
+        [[nodiscard]] bool is_migrated() const noexcept
+        {
+            return migrated_chunks.load(std::memory_order_acquire) == chunk_count;
+        }
+    };
+
+    // Append-only array of values, split into chunks twice as large as the previous one.
+    // Chunks are allocated on first use and never move.
+    class ValueStore
+    {
+        static constexpr size_t first_chunk_size = 1024ull;
+
+        std::array<std::atomic<std::atomic<V>*>, std::numeric_limits<size_t>::digits - 10> chunks{};
+        std::atomic<size_t> count = 0ull;
+
+        static size_t get_chunk(const size_t index) noexcept
+        {
+            return std::bit_width(index / first_chunk_size + 1) - 1;
+        }
+
+    public:
+        ValueStore() = default;
+        ValueStore(const ValueStore&) = delete;
+        ValueStore& operator=(const ValueStore&) = delete;
+
+        ~ValueStore()
+        {
+            for (auto& chunk : chunks)
+            {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+
+        size_t allocate()
+        {
+            const size_t index = count.fetch_add(1, std::memory_order_relaxed);
+            auto& chunk = chunks[get_chunk(index)];
+            if (!chunk.load(std::memory_order_acquire))
+            {
+                auto* storage = new std::atomic<V>[first_chunk_size << get_chunk(index)]();
+                std::atomic<V>* expected = nullptr;
+                if (!chunk.compare_exchange_strong(expected, storage, std::memory_order_acq_rel))
+                {
+                    delete[] storage;
+                }
+            }
+            return index;
+        }
+
+        std::atomic<V>& operator[](const size_t index) const noexcept
+        {
+            const size_t chunk = get_chunk(index);
+            return chunks[chunk].load(std::memory_order_acquire)[index - first_chunk_size * ((1ull << chunk) - 1)];
+        }
+    };
+
+    alignas(cache_line_size) std::atomic<Table*> root;
+    Table* first;
+    alignas(cache_line_size) std::atomic<size_t> size = 0ull;
+    ValueStore values;
+
+    static size_t get_home(const K key, const size_t capacity) noexcept
+    {
+        return HashMapPolicy::PowerOfTwoIndexing::mix(static_cast<size_t>(key)) & (capacity - 1);
+    }
+
+    static void check_key(const K key)
+    {
+        if (key == empty_key || key == moved_key)
+        {
+            throw std::invalid_argument("key is reserved");
+        }
+    }
+
+    // The claiming thread publishes the slot a couple of instructions after its CAS, so spin a little
+    // before yielding.
+    static size_t wait_for_slot(const Cell& cell) noexcept
+    {
+        size_t slot = cell.slot.load(std::memory_order_acquire);
+        for (size_t spin = 0ull; slot == unpublished; ++spin)
+        {
+            if (spin >= 64ull)
+            {
+                std::this_thread::yield();
+            }
+            slot = cell.slot.load(std::memory_order_acquire);
+        }
+        return slot;
+    }
+
+    void start_growth(Table* table)
+    {
+        if (table->next.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        auto* next = new Table(table->capacity * 2, table->load.load(std::memory_order_relaxed));
+        Table* expected = nullptr;
+        if (!table->next.compare_exchange_strong(expected, next, std::memory_order_acq_rel))
+        {
+            delete next;
+        }
+    }
+
+    // Moves the root forward over every table that is fully migrated.
+    void advance_root() noexcept
+    {
+        Table* table = root.load(std::memory_order_acquire);
+        while (table->is_migrated())
+        {
+            Table* next = table->next.load(std::memory_order_acquire);
+            root.compare_exchange_strong(table, next, std::memory_order_acq_rel);
+            table = root.load(std::memory_order_acquire);
+        }
+    }
+
+    // Migrates one chunk of `table` to its next table, if any is left.
+    void help_migrate(Table* table)
+    {
+        const size_t chunk = table->migration_cursor.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= table->chunk_count)
+        {
+            return;
+        }
+
+        Table* next = table->next.load(std::memory_order_acquire);
+        const size_t end = std::min(table->capacity, (chunk + 1) * migration_chunk_size);
+        for (size_t i = chunk * migration_chunk_size; i < end; ++i)
+        {
+            Cell& cell = table->cells[i];
+            K key = cell.key.load(std::memory_order_acquire);
+            if (key == empty_key && cell.key.compare_exchange_strong(key, moved_key, std::memory_order_acq_rel))
+            {
+                continue;
+            }
+            if (key != moved_key)
+            {
+                bool inserted;
+                locate(next, key, wait_for_slot(cell), V(), inserted);
+            }
+        }
+
+        if (table->migrated_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == table->chunk_count)
+        {
+            advance_root();
+        }
+    }
+
+    // Index of the value of `key`, searched from `table` along the chain. A missing key gets a cell in the first
+    // table that is not being migrated, pointing to `slot`, or to a new value set to `initial` when `slot` is
+    // unpublished. A key is always found in the table its probe sequence reaches first, because a probe only
+    // moves on to the next table after a moved marker, and markers are only ever set on empty cells.
+    size_t locate(Table* table, const K key, const size_t slot, const V initial, bool& inserted)
+    {
+        for (;;)
+        {
+            const size_t mask = table->capacity - 1;
+            size_t index = get_home(key, table->capacity);
+            Table* forward = nullptr;
+
+            for (size_t attempt = 0; attempt < table->capacity && !forward; ++attempt, index = (index + 1) & mask)
+            {
+                Cell& cell = table->cells[index];
+                K current = cell.key.load(std::memory_order_acquire);
+                if (current == empty_key)
+                {
+                    // Once a table has a successor, its empty cells are closed instead of claimed.
+                    Table* next = table->next.load(std::memory_order_acquire);
+                    const K replacement = next ? moved_key : key;
+                    if (cell.key.compare_exchange_strong(current, replacement, std::memory_order_acq_rel))
+                    {
+                        if (next)
+                        {
+                            forward = next;
+                            continue;
+                        }
+
+                        inserted = true;
+                        return publish(table, cell, slot, initial);
+                    }
+                }
+
+                if (current == key)
+                {
+                    inserted = false;
+                    return wait_for_slot(cell);
+                }
+                if (current == moved_key)
+                {
+                    forward = table->next.load(std::memory_order_acquire);
+                }
+            }
+
+            // Every cell holds another key, the next table is the only way forward.
+            if (!forward)
+            {
+                start_growth(table);
+                forward = table->next.load(std::memory_order_acquire);
+            }
+            help_migrate(table);
+            table = forward;
+        }
+    }
+
+    // A migrated key brings its existing `slot` along and is already counted in the load of the table.
+    size_t publish(Table* table, Cell& cell, size_t slot, const V initial)
+    {
+        const bool is_new_key = slot == unpublished;
+        if (is_new_key)
+        {
+            slot = values.allocate();
+            values[slot].store(initial, std::memory_order_relaxed);
+        }
+        cell.slot.store(slot, std::memory_order_release);
+
+        if (is_new_key)
+        {
+            size.fetch_add(1, std::memory_order_relaxed);
+            if (table->load.fetch_add(1, std::memory_order_relaxed) + 1 > table->capacity / 4 * 3)
+            {
+                start_growth(table);
+            }
+        }
+        return slot;
+    }
+
+    // Value index of `key`, or unpublished when it is absent. Walks at most the probe sequence of each table
+    // in the chain and never waits.
+    size_t find_slot(const K key) const noexcept
+    {
+        const Table* table = root.load(std::memory_order_acquire);
+        while (table)
+        {
+            const size_t mask = table->capacity - 1;
+            size_t index = get_home(key, table->capacity);
+            const Table* forward = table->next.load(std::memory_order_acquire);
+
+            for (size_t attempt = 0; attempt < table->capacity; ++attempt, index = (index + 1) & mask)
+            {
+                const Cell& cell = table->cells[index];
+                const K current = cell.key.load(std::memory_order_acquire);
+                if (current == key)
+                {
+                    return cell.slot.load(std::memory_order_acquire);
+                }
+                if (current == empty_key)
+                {
+                    return unpublished;
+                }
+                if (current == moved_key)
+                {
+                    forward = table->next.load(std::memory_order_acquire);
+                    break;
+                }
+            }
+            table = forward;
+        }
+        return unpublished;
+    }
+
+    // Writers help an ongoing migration before their own operation so that it always makes progress.
+    std::atomic<V>& locate_for_write(const K key, const V initial, bool& inserted)
+    {
+        check_key(key);
+        Table* table = root.load(std::memory_order_acquire);
+        if (table->next.load(std::memory_order_acquire))
+        {
+            help_migrate(table);
+        }
+        return values[locate(table, key, unpublished, initial, inserted)];
+    }
+
+public:
+    // `initial_capacity` is rounded up to a power of two.
+    explicit LockFreeHashMap(const size_t initial_capacity = 1024ull) :
+        root(new Table(std::bit_ceil(std::max(initial_capacity, size_t(16ull))), 0ull))
+    {
+        first = root.load(std::memory_order_relaxed);
+    }
+
+    LockFreeHashMap(const LockFreeHashMap&) = delete;
+    LockFreeHashMap& operator=(const LockFreeHashMap&) = delete;
+
+    ~LockFreeHashMap()
+    {
+        while (first)
+        {
+            delete std::exchange(first, first->next.load(std::memory_order_relaxed));
+        }
+    }
+
+    // Wait-free. A key whose insertion has not published its value yet is reported absent.
+    [[nodiscard]] std::optional<V> find(const K key) const
+    {
+        if (const size_t slot = find_slot(key); slot != unpublished)
+        {
+            return values[slot].load(std::memory_order_acquire);
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] bool contains(const K key) const
+    {
+        return find_slot(key) != unpublished;
+    }
+
+    // Returns false and leaves the value untouched when the key is already present.
+    bool insert(const K key, const V value)
+    {
+        bool inserted;
+        locate_for_write(key, value, inserted);
+        return inserted;
+    }
+
+    void insert_or_assign(const K key, const V value)
+    {
+        bool inserted;
+        std::atomic<V>& slot = locate_for_write(key, value, inserted);
+        if (!inserted)
+        {
+            slot.store(value, std::memory_order_release);
+        }
+    }
+
+    // Adds `delta` to the value of `key`, starting from 0 when the key is absent, and returns the previous value.
+    V fetch_add(const K key, const V delta)
+    {
+        bool inserted;
+        return locate_for_write(key, V(), inserted).fetch_add(delta, std::memory_order_acq_rel);
+    }
+
+    // Replaces the value of `key` with `desired` if it equals `expected`, otherwise loads it into `expected`.
+    // Returns false as well when the key is absent.
+    bool compare_exchange(const K key, V& expected, const V desired)
+    {
+        if (const size_t slot = find_slot(key); slot != unpublished)
+        {
+            return values[slot].compare_exchange_strong(expected, desired, std::memory_order_acq_rel);
+        }
+        return false;
+    }
+
+    // Number of keys whose insertion completed, may lag behind while other threads insert.
+    [[nodiscard]] size_t get_size() const noexcept
+    {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t get_capacity() const noexcept
+    {
+        return root.load(std::memory_order_acquire)->capacity;
+    }
+};
@@ -0,0 +1,322 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Lock-free multi-producer single-consumer queue (Vyukov). Nodes are linked like List's,
+// with an atomic next pointer. A producer publishes its node with a single exchange on the
+// producer end, so push is wait-free. The consumer owns the other end and never contends with producers.
+// push() may be called from any thread, try_pop(), drain() and is_empty() from one consumer thread at a time.
+// Every push allocates a node; IntrusiveMPSCQueue below links the elements themselves instead.
+template<typename T>
+class MPSCQueue
+{
+    static constexpr size_t cache_line_size = 64ull;
+
+    struct Node
+    {
+        // Constructed only for queued elements. The node at the consumer end is a placeholder.
+        union
+        {
+            T data;
+        };
+        std::atomic<Node*> next = nullptr;
+
+        Node()
+        {
+        }
+
+        ~Node()
+        {
+        }
+    };
+
+    // Producer end, last node pushed.
+    alignas(cache_line_size) std::atomic<Node*> head;
+    // Consumer end, placeholder preceding the oldest element.
+    alignas(cache_line_size) Node* tail;
+
+    // A producer has exchanged the head but not linked its node yet. That is a window
+    // of a couple of instructions, so the consumer spins a little before yielding.
+    static Node* wait_for_next(Node* node) noexcept
+    {
+        Node* next = node->next.load(std::memory_order_acquire);
+        for (size_t spin = 0ull; !next; ++spin)
+        {
+            if (spin >= 64ull)
+            {
+                std::this_thread::yield();
+            }
+            next = node->next.load(std::memory_order_acquire);
+        }
+        return next;
+    }
+
+    // `next` becomes the placeholder once its element is moved out.
+    T take(Node* next)
+    {
+        T element(std::move(next->data));
+        std::destroy_at(&next->data);
+        delete tail;
+        tail = next;
+        return element;
+    }
+
+public:
+    MPSCQueue() : head(new Node()), tail(head.load(std::memory_order_relaxed))
+    {
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    ~MPSCQueue()
+    {
+        Node* it = tail->next.load(std::memory_order_acquire);
+        delete tail;
+        while (it)
+        {
+            Node* next = it->next.load(std::memory_order_acquire);
+            std::destroy_at(&it->data);
+            delete it;
+            it = next;
+        }
+    }
+
+    template<typename U = T>
+    void push(U&& element)
+    {
+        emplace(std::forward<U>(element));
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+        auto new_node = new Node();
+        try
+        {
+            std::construct_at(&new_node->data, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            delete new_node;
+            throw;
+        }
+
+        Node* previous = head.exchange(new_node, std::memory_order_acq_rel);
+        previous->next.store(new_node, std::memory_order_release);
+    }
+
+    // Returns the oldest element, or nothing when no element is visible yet.
+    std::optional<T> try_pop()
+    {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next)
+            return std::nullopt;
+
+        return take(next);
+    }
+
+    // Hands every element pushed before the call to `function`, oldest first, and returns their count.
+    // The batch is delimited by one atomic read of the producer end: elements pushed meanwhile are left
+    // for the next call, so a drain always terminates under a steady stream of producers.
+    template<typename Function>
+    size_t drain(Function&& function)
+    {
+        Node* last = head.load(std::memory_order_acquire);
+        size_t count = 0ull;
+
+        while (tail != last)
+        {
+            function(take(wait_for_next(tail)));
+            ++count;
+        }
+        return count;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+template<typename T, typename Tag_>
+class IntrusiveMPSCQueue;
+
+// Link field embedded in the objects of an IntrusiveMPSCQueue, as a public base class. An object can wait in
+// as many queues as it has hooks, each hook base told apart by its Tag_, but in only one queue per hook.
+template<typename Tag_ = void>
+class MPSCQueueHook
+{
+    template<typename T, typename>
+    friend class IntrusiveMPSCQueue;
+
+    std::atomic<MPSCQueueHook*> next = nullptr;
+
+public:
+    MPSCQueueHook() = default;
+
+    MPSCQueueHook(const MPSCQueueHook&) noexcept
+    {
+    }
+
+    MPSCQueueHook& operator=(const MPSCQueueHook&) noexcept
+    {
+        return *this;
+    }
+};
+
+// Intrusive variant of MPSCQueue (Vyukov): producers link the objects through their MPSCQueueHook<Tag_> base,
+// so neither push nor pop allocates. The queue does not own its elements, an object must outlive its stay in
+// the queue and the consumer takes it back from try_pop() or drain(). A stub hook stands for the consumer end
+// when the queue runs dry and is pushed back behind the last element so that element can be handed out.
+// push() may be called from any thread, try_pop(), drain() and is_empty() from one consumer thread at a time.
+template<typename T, typename Tag_ = void>
+class IntrusiveMPSCQueue
+{
+    using Hook = MPSCQueueHook<Tag_>;
+
+    static constexpr size_t cache_line_size = 64ull;
+
+    // Producer end, last hook pushed.
+    alignas(cache_line_size) std::atomic<Hook*> head;
+    // Consumer end, oldest hook still linked, possibly the stub.
+    alignas(cache_line_size) Hook* tail;
+    Hook stub;
+
+    static Hook& hook_of(T& element) noexcept
+    {
+        static_assert(std::derived_from<T, Hook>, "T must derive publicly from MPSCQueueHook<Tag_>");
+        return static_cast<Hook&>(element);
+    }
+
+    static T& owner_of(Hook* hook) noexcept
+    {
+        return static_cast<T&>(*hook);
+    }
+
+    // Same window as MPSCQueue::wait_for_next: a producer has exchanged the head but not linked its hook yet.
+    static Hook* wait_for_next(Hook* hook) noexcept
+    {
+        Hook* next = hook->next.load(std::memory_order_acquire);
+        for (size_t spin = 0ull; !next; ++spin)
+        {
+            if (spin >= 64ull)
+            {
+                std::this_thread::yield();
+            }
+            next = hook->next.load(std::memory_order_acquire);
+        }
+        return next;
+    }
+
+    void link(Hook* hook) noexcept
+    {
+        hook->next.store(nullptr, std::memory_order_relaxed);
+        Hook* previous = head.exchange(hook, std::memory_order_acq_rel);
+        previous->next.store(hook, std::memory_order_release);
+    }
+
+    // Unlinks the oldest element. When `wait` is false, nullptr also means a producer is halfway through
+    // its push and the element is not reachable yet; when it is true, nullptr only means the queue is empty.
+    T* pop(const bool wait) noexcept
+    {
+        Hook* first = tail;
+        Hook* next = first->next.load(std::memory_order_acquire);
+        if (first == &stub)
+        {
+            if (!next)
+            {
+                if (!wait || head.load(std::memory_order_acquire) == &stub)
+                    return nullptr;
+                next = wait_for_next(first);
+            }
+            tail = next;
+            first = next;
+            next = first->next.load(std::memory_order_acquire);
+        }
+
+        if (!next)
+        {
+            if (first != head.load(std::memory_order_acquire))
+            {
+                if (!wait)
+                    return nullptr;
+            }
+            else
+            {
+                // `first` is the last element, the stub takes its place at the producer end.
+                link(&stub);
+            }
+            next = wait_for_next(first);
+        }
+
+        tail = next;
+        return &owner_of(first);
+    }
+
+public:
+    IntrusiveMPSCQueue() noexcept : head(&stub), tail(&stub)
+    {
+    }
+
+    IntrusiveMPSCQueue(const IntrusiveMPSCQueue&) = delete;
+    IntrusiveMPSCQueue& operator=(const IntrusiveMPSCQueue&) = delete;
+
+    // `element` must not be waiting in this queue already.
+    void push(T& element) noexcept
+    {
+        link(&hook_of(element));
+    }
+
+    // Returns the oldest element, or nullptr when no element is visible yet.
+    T* try_pop() noexcept
+    {
+        return pop(false);
+    }
+
+    // Hands every element pushed before the call to `function`, oldest first, and returns their count.
+    // As with MPSCQueue::drain, the batch ends at the producer end read on entry. An element is unlinked
+    // before `function` sees it, so `function` may push it again or destroy it.
+    template<typename Function>
+    size_t drain(Function&& function)
+    {
+        Hook* last = head.load(std::memory_order_acquire);
+        size_t count = 0ull;
+
+        if (last == &stub)
+        {
+            // The stub was pushed behind the elements of the batch, which end where it is reached.
+            while (tail != &stub)
+            {
+                function(*pop(true));
+                ++count;
+            }
+            return count;
+        }
+
+        while (T* element = pop(true))
+        {
+            const bool is_last = &hook_of(*element) == last;
+            function(*element);
+            ++count;
+            if (is_last)
+                break;
+        }
+        return count;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return head.load(std::memory_order_acquire) == &stub && tail == &stub;
+    }
+};
@@ -0,0 +1,73 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+// Shared memory mapping of a whole file (POSIX mmap). Errors are reported as std::system_error.
+class MappedFile
+{
+public:
+    enum class Mode
+    {
+        // The file must exist, the mapping can't be written.
+        ReadOnly,
+        // Opens the file with its content, creating it when missing.
+        ReadWrite,
+        // Creates the file or empties an existing one.
+        Truncate
+    };
+
+    MappedFile() = default;
+    MappedFile(const std::filesystem::path& path, Mode mode);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    friend void swap(MappedFile& first, MappedFile& second) noexcept;
+
+    void open(const std::filesystem::path& path, Mode mode);
+    void close() noexcept;
+
+    // Sets the file length and remaps it, the mapping address may change.
+    void resize(size_t new_size);
+
+    // Writes the first `byte_count` bytes of the mapping back to the file and waits for the disk.
+    void sync(size_t byte_count) const;
+
+    [[nodiscard]] std::byte* data() const noexcept
+    {
+        return mapping;
+    }
+
+    [[nodiscard]] size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return descriptor != -1;
+    }
+
+    [[nodiscard]] bool is_read_only() const noexcept
+    {
+        return read_only;
+    }
+
+private:
+    int descriptor = -1;
+    std::byte* mapping = nullptr;
+    size_t size = 0ull;
+    bool read_only = false;
+
+    void map(size_t new_size);
+    void unmap() noexcept;
+};
@@ -0,0 +1,315 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "MappedFile.h"
+
+// Vector whose storage is a file mapped in memory. The file is nothing but the records back to back,
+// so opening an existing dataset maps it as is, without parsing or copying, and the page cache shares it
+// between processes. Growing reserves room at the end of the file; flush(), close() and shrink_to_fit() cut it off.
+// Since the element count is the file length, a file caught with its reserved tail (a reader opening it while
+// a writer has grown it since its last flush, or a reopen after a crash) reads that tail as zero-filled elements.
+template<typename T>
+class MappedVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores raw bytes, T must be trivially copyable");
+
+    MappedFile file;
+    size_t size = 0ull;
+
+    T* array() const noexcept
+    {
+        return reinterpret_cast<T*>(file.data());
+    }
+
+    void throw_if_read_only() const
+    {
+        if (file.is_read_only())
+        {
+            throw std::logic_error("MappedVector is read-only");
+        }
+    }
+
+    void reserve_impl(const size_t new_capacity, const bool is_from_shrink_to_fit)
+    {
+        if (get_capacity() >= new_capacity && !is_from_shrink_to_fit)
+            return;
+
+        throw_if_read_only();
+        file.resize(new_capacity * sizeof(T));
+    }
+
+    [[nodiscard]] size_t grown_capacity(const size_t required_capacity) const noexcept
+    {
+        constexpr size_t minimum_capacity = std::max<size_t>(4096ull / sizeof(T), 1ull);
+        return std::max({required_capacity, get_capacity() * 2, minimum_capacity});
+    }
+
+public:
+    using Mode = MappedFile::Mode;
+
+    MappedVector() = default;
+
+    explicit MappedVector(const std::filesystem::path& path, const Mode mode = Mode::ReadWrite)
+    {
+        open(path, mode);
+    }
+
+    MappedVector(MappedVector&& other) noexcept : file(std::move(other.file)), size(std::exchange(other.size, 0ull))
+    {
+    }
+
+    MappedVector& operator=(MappedVector&& other) noexcept
+    {
+        MappedVector moved(std::move(other));
+        swap(*this, moved);
+        return *this;
+    }
+
+    ~MappedVector()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    friend void swap(MappedVector& first, MappedVector& second) noexcept
+    {
+        using std::swap;
+        swap(first.file, second.file);
+        swap(first.size, second.size);
+    }
+
+    // Every record of an existing file becomes an element. A read-only vector ignores a trailing partial record,
+    // a read-write one refuses the file with std::runtime_error, since trimming the reserved tail would cut it off.
+    void open(const std::filesystem::path& path, const Mode mode = Mode::ReadWrite)
+    {
+        close();
+        file.open(path, mode);
+        if (!file.is_read_only() && file.get_size() % sizeof(T) != 0ull)
+        {
+            file.close();
+            throw std::runtime_error("MappedVector: file ends with a partial record");
+        }
+        size = file.get_size() / sizeof(T);
+    }
+
+    // Trims the reserved tail so the file holds exactly the elements, then unmaps it.
+    void close()
+    {
+        if (file.is_open() && !file.is_read_only())
+        {
+            file.resize(size * sizeof(T));
+        }
+        file.close();
+        size = 0ull;
+    }
+
+    // Trims the reserved tail, then blocks until the elements are written to disk, so the file holds exactly
+    // the elements. Like shrink_to_fit(), it may remap the storage, and the next growth reserves again.
+    void flush()
+    {
+        if (file.is_open() && !file.is_read_only())
+        {
+            file.resize(size * sizeof(T));
+        }
+        file.sync(size * sizeof(T));
+    }
+
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return file.is_open();
+    }
+
+    [[nodiscard]] bool is_read_only() const noexcept
+    {
+        return file.is_read_only();
+    }
+
+    [[nodiscard]] size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    [[nodiscard]] size_t get_capacity() const noexcept
+    {
+        return file.get_size() / sizeof(T);
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return size == 0ull;
+    }
+
+    void reserve(const size_t new_capacity)
+    {
+        reserve_impl(new_capacity, false);
+    }
+
+    template<typename U = T>
+    void push_back(U&& element)
+    {
+        emplace_back(std::forward<U>(element));
+    }
+
+    // The element is built before a possible remap, so arguments referring to this vector stay valid.
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        throw_if_read_only();
+
+        T element(std::forward<Args>(args)...);
+        if (size >= get_capacity())
+        {
+            reserve(grown_capacity(size + 1));
+        }
+
+        std::memcpy(static_cast<void*>(array() + size), &element, sizeof(T));
+        return array()[size++];
+    }
+
+    template<std::ranges::input_range R>
+    void append_range(R&& range)
+    {
+        throw_if_read_only();
+
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>)
+        {
+            const auto count = static_cast<size_t>(std::ranges::distance(range));
+            if (size + count > get_capacity())
+            {
+                reserve(grown_capacity(size + count));
+            }
+
+            std::ranges::uninitialized_copy_n(std::ranges::begin(range), count, array() + size, array() + size + count);
+            size += count;
+        }
+        else
+        {
+            for (auto&& element : range)
+            {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
+        }
+    }
+
+    void erase_swap(const size_t index)
+    {
+        throw_if_read_only();
+        array()[index] = array()[--size];
+    }
+
+    void pop_back()
+    {
+        throw_if_read_only();
+        if (size)
+        {
+            --size;
+        }
+    }
+
+    void clear()
+    {
+        throw_if_read_only();
+        size = 0ull;
+    }
+
+    void resize(const size_t count, const T& initializer = T())
+    {
+        throw_if_read_only();
+        if (count > size)
+        {
+            if (count > get_capacity())
+            {
+                reserve(grown_capacity(count));
+            }
+            std::uninitialized_fill(array() + size, array() + count, initializer);
+        }
+        size = count;
+    }
+
+    void shrink_to_fit()
+    {
+        reserve_impl(size, true);
+    }
+
+    // Element access never checks the mode: a read-only file is mapped PROT_READ, so reading through
+    // these is fine and storing through them faults.
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < size && "index out of bound");
+        return array()[index];
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        assert(index < size && "index out of bound");
+        return array()[index];
+    }
+
+    T& at(size_t index)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("index out of bound");
+        }
+
+        return array()[index];
+    }
+
+    const T& at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("index out of bound");
+        }
+
+        return array()[index];
+    }
+
+    [[nodiscard]] T* data() noexcept
+    {
+        return array();
+    }
+
+    [[nodiscard]] const T* data() const noexcept
+    {
+        return array();
+    }
+
+    T* begin() noexcept
+    {
+        return array();
+    }
+
+    T* end() noexcept
+    {
+        return array() + size;
+    }
+
+    const T* begin() const noexcept
+    {
+        return array();
+    }
+
+    const T* end() const noexcept
+    {
+        return array() + size;
+    }
+};
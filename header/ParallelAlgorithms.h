@@ -0,0 +1,273 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "Vector.h"
+
+// Data-parallel loops over the contiguous storage of a Vector. The range is cut in chunks that
+// the calling thread and the pool's workers pick dynamically, so uneven work still balances.
+namespace Parallel
+{
+    struct Options
+    {
+        // Elements per chunk, 0 picks about four chunks per thread.
+        size_t grain_size = 0ull;
+        // Threads working on one call (calling thread included), 0 uses the whole pool.
+        size_t max_threads = 0ull;
+        // nullptr uses ThreadPool::get_default().
+        ThreadPool* pool = nullptr;
+    };
+
+    namespace detail
+    {
+        inline constexpr size_t cache_line_size = 64ull;
+
+        // Chunk k covers [head + (k - 1) * chunk_size, ...) when head is non zero, so with
+        // head set to the distance to the next cache line no line is written by two threads.
+        struct ChunkLayout
+        {
+            size_t length = 0ull;
+            size_t head = 0ull;
+            size_t chunk_size = 1ull;
+
+            [[nodiscard]] size_t chunk_count() const noexcept
+            {
+                if (length <= head)
+                    return length ? 1ull : 0ull;
+                return (head ? 1ull : 0ull) + (length - head + chunk_size - 1ull) / chunk_size;
+            }
+
+            [[nodiscard]] std::pair<size_t, size_t> bounds(const size_t chunk) const noexcept
+            {
+                if (head && chunk == 0ull)
+                    return {0ull, std::min<size_t>(head, length)};
+
+                const size_t begin = head + (chunk - (head ? 1ull : 0ull)) * chunk_size;
+                return {begin, std::min<size_t>(begin + chunk_size, length)};
+            }
+
+            [[nodiscard]] size_t chunk_of(const size_t begin) const noexcept
+            {
+                if (!head)
+                    return begin / chunk_size;
+                return begin < head ? 0ull : 1ull + (begin - head) / chunk_size;
+            }
+        };
+
+        template<typename T>
+        ChunkLayout make_layout(const T* data, const size_t length, const size_t thread_count, const Options& options)
+        {
+            constexpr size_t elements_per_line = sizeof(T) < cache_line_size && cache_line_size % sizeof(T) == 0ull
+                ? cache_line_size / sizeof(T)
+                : 1ull;
+
+            ChunkLayout layout;
+            layout.length = length;
+
+            size_t chunk_size = options.grain_size ? options.grain_size : length / (thread_count * 4ull);
+            chunk_size = std::max(chunk_size, elements_per_line);
+            layout.chunk_size = (chunk_size + elements_per_line - 1ull) / elements_per_line * elements_per_line;
+
+            const auto address = reinterpret_cast<uintptr_t>(data);
+            if (elements_per_line > 1ull && address % sizeof(T) == 0ull)
+            {
+                layout.head = (cache_line_size - address % cache_line_size) % cache_line_size / sizeof(T);
+            }
+            return layout;
+        }
+
+        [[nodiscard]] ThreadPool& pool_of(const Options& options);
+
+        [[nodiscard]] size_t thread_count_of(const Options& options);
+
+        // Runs body(begin, end) for every chunk, on at most `thread_count` threads including the
+        // calling one, and returns once all of them are done. The first exception thrown by the
+        // body is rethrown here after the remaining chunks have been skipped.
+        void run_chunks(const ChunkLayout& layout, size_t thread_count, ThreadPool& pool,
+                        const std::function<void(size_t, size_t)>& body);
+
+        // Keeps each partial result on its own cache line.
+        template<typename R>
+        struct alignas(cache_line_size) PaddedSlot
+        {
+            std::optional<R> value;
+        };
+
+        // Runs chunk_fold(begin, end) -> R on every chunk and returns the partial results in chunk order.
+        template<typename R, typename T, typename ChunkFold>
+        std::vector<PaddedSlot<R>> fold_chunks(const T* data, const size_t length, const Options& options, ChunkFold chunk_fold)
+        {
+            const size_t thread_count = thread_count_of(options);
+            const auto layout = make_layout(data, length, thread_count, options);
+
+            std::vector<PaddedSlot<R>> partials(layout.chunk_count());
+            run_chunks(layout, thread_count, pool_of(options),
+                [&](const size_t begin, const size_t end)
+                {
+                    partials[layout.chunk_of(begin)].value.emplace(chunk_fold(begin, end));
+                });
+            return partials;
+        }
+    }
+
+    template<typename T, typename Allocator_, typename Function>
+    void parallel_for_each(Vector<T, Allocator_>& vector, Function function, const Options& options = {})
+    {
+        T* data = vector.data();
+        const size_t thread_count = detail::thread_count_of(options);
+        detail::run_chunks(detail::make_layout(data, vector.get_size(), thread_count, options), thread_count, detail::pool_of(options),
+            [&](const size_t begin, const size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    function(data[i]);
+                }
+            });
+    }
+
+    template<typename T, typename Allocator_, typename Function>
+    void parallel_for_each(const Vector<T, Allocator_>& vector, Function function, const Options& options = {})
+    {
+        const T* data = vector.data();
+        const size_t thread_count = detail::thread_count_of(options);
+        detail::run_chunks(detail::make_layout(data, vector.get_size(), thread_count, options), thread_count, detail::pool_of(options),
+            [&](const size_t begin, const size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    function(data[i]);
+                }
+            });
+    }
+
+    // output[i] = function(input[i]). `output` is resized to the size of `input`,
+    // chunks are laid out on the output so no two threads write the same cache line.
+    template<typename T, typename InputAllocator_, typename U, typename OutputAllocator_, typename Function>
+    void parallel_transform(const Vector<T, InputAllocator_>& input, Vector<U, OutputAllocator_>& output, Function function, const Options& options = {})
+    {
+        output.resize(input.get_size());
+
+        const T* source = input.data();
+        U* destination = output.data();
+        const size_t thread_count = detail::thread_count_of(options);
+        detail::run_chunks(detail::make_layout(destination, input.get_size(), thread_count, options), thread_count, detail::pool_of(options),
+            [&](const size_t begin, const size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    destination[i] = function(source[i]);
+                }
+            });
+    }
+
+    // `operation` must be associative over R: chunks are folded independently then combined in order.
+    // Each chunk starts from its first element converted to R, and every element is converted to R before
+    // being folded, so the operation only ever sees R values. Use the overload taking a separate fold and
+    // combine when the element and result types differ.
+    template<typename T, typename Allocator_, typename R, typename BinaryOperation = std::plus<>>
+        requires std::convertible_to<const T&, R> && std::invocable<BinaryOperation&, R, R>
+    R parallel_reduce(const Vector<T, Allocator_>& vector, R initial, BinaryOperation operation = {}, const Options& options = {})
+    {
+        const T* data = vector.data();
+        auto partials = detail::fold_chunks<R>(data, vector.get_size(), options,
+            [&](const size_t begin, const size_t end)
+            {
+                R partial = static_cast<R>(data[begin]);
+                for (size_t i = begin + 1ull; i < end; ++i)
+                {
+                    partial = operation(std::move(partial), static_cast<R>(data[i]));
+                }
+                return partial;
+            });
+
+        for (auto& partial : partials)
+        {
+            initial = operation(std::move(initial), std::move(*partial.value));
+        }
+        return initial;
+    }
+
+    // Every chunk is folded from a copy of `identity` with fold(R, const T&), then the partial results
+    // are merged in order with combine(R, R), starting from `identity` again. `combine` must be
+    // associative and `identity` neutral for it, e.g. 0 with std::plus, or the result depends on the chunking.
+    template<typename T, typename Allocator_, typename R, typename Fold, typename Combine>
+        requires std::invocable<Fold&, R, const T&> && std::invocable<Combine&, R, R>
+    R parallel_reduce(const Vector<T, Allocator_>& vector, const R& identity, Fold fold, Combine combine, const Options& options = {})
+    {
+        const T* data = vector.data();
+        auto partials = detail::fold_chunks<R>(data, vector.get_size(), options,
+            [&](const size_t begin, const size_t end)
+            {
+                R partial = identity;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    partial = fold(std::move(partial), data[i]);
+                }
+                return partial;
+            });
+
+        R result = identity;
+        for (auto& partial : partials)
+        {
+            result = combine(std::move(result), std::move(*partial.value));
+        }
+        return result;
+    }
+
+    // Sorts one run per thread in parallel, then merges neighbouring runs pairwise,
+    // each merge round running its merges in parallel.
+    template<typename T, typename Allocator_, typename Compare = std::less<>>
+    void parallel_sort(Vector<T, Allocator_>& vector, Compare compare = {}, const Options& options = {})
+    {
+        T* data = vector.data();
+        const size_t length = vector.get_size();
+        const size_t thread_count = detail::thread_count_of(options);
+        ThreadPool& pool = detail::pool_of(options);
+
+        const size_t minimum_run = options.grain_size ? options.grain_size : 4096ull;
+        const size_t run_count = std::max<size_t>(1ull, std::min<size_t>(thread_count, length / minimum_run));
+        if (run_count == 1ull)
+        {
+            std::sort(data, data + length, compare);
+            return;
+        }
+
+        const size_t run_size = (length + run_count - 1ull) / run_count;
+        detail::run_chunks(detail::ChunkLayout{run_count, 0ull, 1ull}, thread_count, pool,
+            [&](const size_t begin, const size_t end)
+            {
+                for (size_t run = begin; run < end; ++run)
+                {
+                    std::sort(data + std::min<size_t>(run * run_size, length), data + std::min<size_t>((run + 1ull) * run_size, length), compare);
+                }
+            });
+
+        for (size_t width = run_size; width < length; width *= 2ull)
+        {
+            const size_t merge_count = (length + 2ull * width - 1ull) / (2ull * width);
+            detail::run_chunks(detail::ChunkLayout{merge_count, 0ull, 1ull}, thread_count, pool,
+                [&](const size_t begin, const size_t end)
+                {
+                    for (size_t merge = begin; merge < end; ++merge)
+                    {
+                        const size_t first = merge * 2ull * width;
+                        const size_t middle = std::min<size_t>(first + width, length);
+                        const size_t last = std::min<size_t>(first + 2ull * width, length);
+                        std::inplace_merge(data + first, data + middle, data + last, compare);
+                    }
+                });
+        }
+    }
+}
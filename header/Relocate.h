@@ -0,0 +1,52 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// A type is trivially relocatable when moving it to a new address and forgetting the old one
+// is equivalent to a raw byte copy. Specialize this trait to opt in user types
+// (e.g. types holding a unique_ptr or a heap buffer but no self-pointer).
+template<typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+// Moves `count` objects from `source` into the uninitialized storage at `destination`
+// and ends the lifetime of the source objects. Both ranges must not overlap.
+template<typename T>
+void relocate(T* source, const size_t count, T* destination)
+{
+    if (count == 0ull)
+        return;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+    }
+    else
+    {
+        size_t constructed = 0ull;
+        try
+        {
+            for (; constructed < count; ++constructed)
+            {
+                std::construct_at(destination + constructed, std::move_if_noexcept(source[constructed]));
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(destination, constructed);
+            throw;
+        }
+        std::destroy_n(source, count);
+    }
+}
@@ -0,0 +1,88 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+
+#include "Vector.h"
+
+// Vector keeping its first InlineCapacity_ elements inside the object itself,
+// the heap is only used once the vector grows past that.
+template<typename T, size_t InlineCapacity_ = 8ull, typename Allocator_ = std::allocator<T>>
+class SmallVector : public Vector<T, Allocator_>
+{
+    using Base = Vector<T, Allocator_>;
+
+    static_assert(InlineCapacity_ > 0ull, "SmallVector needs at least one inline element");
+
+    alignas(T) std::byte inline_storage[InlineCapacity_ * sizeof(T)];
+
+public:
+    SmallVector() noexcept : SmallVector(Allocator_())
+    {
+    }
+
+    explicit SmallVector(const Allocator_& allocator_) noexcept : Base(reinterpret_cast<T*>(inline_storage), InlineCapacity_, allocator_)
+    {
+    }
+
+    SmallVector(std::initializer_list<T> list, const Allocator_& allocator_ = Allocator_()) : SmallVector(allocator_)
+    {
+        this->append_range(list);
+    }
+
+    SmallVector(const SmallVector& other) :
+        SmallVector(std::allocator_traits<Allocator_>::select_on_container_copy_construction(other.get_allocator()))
+    {
+        this->append_copy_of(other);
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector(other.get_allocator())
+    {
+        this->take_elements_from(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            this->append_copy_of(other);
+        }
+        return *this;
+    }
+
+    // With an allocator that may compare unequal, elements owned by a different allocator are relocated
+    // and can need an allocation, so the move is only noexcept for an always-equal allocator.
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                         std::allocator_traits<Allocator_>::is_always_equal::value)
+    {
+        if (this != &other)
+        {
+            this->release_storage();
+            this->take_elements_from(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        this->release_storage();
+    }
+
+    [[nodiscard]] bool is_small() const noexcept
+    {
+        return this->is_inline();
+    }
+};
+
+namespace pmr
+{
+    template<typename T, size_t InlineCapacity_ = 8ull>
+    using SmallVector = ::SmallVector<T, InlineCapacity_, std::pmr::polymorphic_allocator<T>>;
+}
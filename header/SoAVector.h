@@ -0,0 +1,462 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Relocate.h"
+
+// Structure-of-arrays counterpart of Vector<std::tuple<Fields...>>: every field lives in its own
+// cache-line aligned array, so a pass reading one field only loads that field from memory.
+// Rows are accessed through tuples of references.
+template<typename... Fields>
+class SoAVector
+{
+    static_assert(sizeof...(Fields) > 0ull, "SoAVector needs at least one field");
+    static_assert((std::is_nothrow_move_constructible_v<Fields> && ...),
+                  "SoAVector fields must be nothrow move constructible, a failed relocation would tear rows apart");
+
+    static constexpr size_t CacheLineSize = 64ull;
+
+    using Arrays = std::tuple<Fields*...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+    Arrays arrays{};
+    size_t capacity = 0ull;
+    size_t size = 0ull;
+
+    template<typename F>
+    static constexpr std::align_val_t field_alignment{std::max(alignof(F), CacheLineSize)};
+
+    static Arrays allocate(const size_t count)
+    {
+        Arrays new_arrays{};
+        try
+        {
+            std::apply([count](auto*&... array)
+            {
+                ((array = static_cast<std::remove_reference_t<decltype(*array)>*>(
+                    ::operator new(count * sizeof(*array), field_alignment<std::remove_reference_t<decltype(*array)>>))), ...);
+            }, new_arrays);
+        }
+        catch (...)
+        {
+            deallocate(new_arrays);
+            throw;
+        }
+        return new_arrays;
+    }
+
+    static void deallocate(Arrays& buffers) noexcept
+    {
+        std::apply([](auto*&... array)
+        {
+            ((array ? ::operator delete(array, field_alignment<std::remove_reference_t<decltype(*array)>>) : void()), ...);
+        }, buffers);
+    }
+
+    template<size_t... I>
+    void destroy_row(const size_t index, const size_t field_count, std::index_sequence<I...>) noexcept
+    {
+        ((I < field_count ? std::destroy_at(std::get<I>(arrays) + index) : void()), ...);
+    }
+
+    // Constructs every field of a row from the matching element of `values`.
+    // Fields already built are destroyed if a later one throws.
+    template<typename Tuple, size_t... I>
+    static void construct_row(Arrays& target, const size_t index, Tuple&& values, std::index_sequence<I...>)
+    {
+        size_t constructed = 0ull;
+        try
+        {
+            ((std::construct_at(std::get<I>(target) + index, std::get<I>(std::forward<Tuple>(values))), ++constructed), ...);
+        }
+        catch (...)
+        {
+            ((I < constructed ? std::destroy_at(std::get<I>(target) + index) : void()), ...);
+            throw;
+        }
+    }
+
+    template<size_t... I>
+    void relocate_rows(Arrays& target, std::index_sequence<I...>) noexcept
+    {
+        (relocate(std::get<I>(arrays), size, std::get<I>(target)), ...);
+    }
+
+    void replace_storage(Arrays& new_arrays, const size_t new_capacity) noexcept
+    {
+        relocate_rows(new_arrays, Indices{});
+        deallocate(arrays);
+        arrays = new_arrays;
+        capacity = new_capacity;
+    }
+
+    [[nodiscard]] size_t grown_capacity(const size_t required_capacity) const noexcept
+    {
+        return std::max(required_capacity, capacity * 2);
+    }
+
+    // The new row is constructed before the old arrays are released, so arguments
+    // referring to elements of this vector stay valid.
+    template<typename Tuple>
+    void grow_and_construct_back(Tuple&& values)
+    {
+        const size_t new_capacity = grown_capacity(size + 1);
+        Arrays new_arrays = allocate(new_capacity);
+
+        try
+        {
+            construct_row(new_arrays, size, std::forward<Tuple>(values), Indices{});
+        }
+        catch (...)
+        {
+            deallocate(new_arrays);
+            throw;
+        }
+
+        replace_storage(new_arrays, new_capacity);
+        ++size;
+    }
+
+    template<typename Tuple>
+    void construct_back(Tuple&& values)
+    {
+        if (size >= capacity)
+        {
+            grow_and_construct_back(std::forward<Tuple>(values));
+            return;
+        }
+
+        construct_row(arrays, size, std::forward<Tuple>(values), Indices{});
+        ++size;
+    }
+
+    template<typename Row>
+    Row row_at(const size_t index) const noexcept
+    {
+        return std::apply([index](auto*... array) { return Row(array[index]...); }, arrays);
+    }
+
+    template<bool IsConst>
+    class Iterator
+    {
+        friend class SoAVector;
+
+        using Owner = std::conditional_t<IsConst, const SoAVector, SoAVector>;
+
+        Owner* owner = nullptr;
+        size_t index = 0ull;
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::tuple<Fields...>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, std::tuple<const Fields&...>, std::tuple<Fields&...>>;
+
+        Iterator() = default;
+
+        Iterator(Owner* owner_, const size_t index_) : owner(owner_), index(index_)
+        {
+        }
+
+        reference operator*() const
+        {
+            return owner->template row_at<reference>(index);
+        }
+
+        bool operator==(const Iterator & other) const
+        {
+            return index == other.index && owner == other.owner;
+        }
+
+        auto operator<=>(const Iterator & other) const
+        {
+            return index <=> other.index;
+        }
+
+        Iterator& operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        Iterator& operator--()
+        {
+            --index;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        Iterator& operator+=(difference_type offset) {
+            index += offset;
+            return *this;
+        }
+
+        Iterator operator+(difference_type offset) const {
+            Iterator tmp = *this;
+            tmp += offset;
+            return tmp;
+        }
+
+        friend Iterator operator+(difference_type offset, const Iterator& iterator) {
+            return iterator + offset;
+        }
+
+        Iterator& operator-=(difference_type offset) {
+            index -= offset;
+            return *this;
+        }
+
+        Iterator operator-(difference_type offset) const {
+            Iterator tmp = *this;
+            tmp -= offset;
+            return tmp;
+        }
+
+        difference_type operator-(const Iterator& other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        reference operator[](difference_type offset) const {
+            return *(*this + offset);
+        }
+    };
+
+public:
+    template<size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    SoAVector() = default;
+
+    SoAVector(std::initializer_list<value_type> list)
+    {
+        reserve(list.size());
+        for (const auto& row : list)
+        {
+            push_back(row);
+        }
+    }
+
+    SoAVector(const SoAVector& other)
+    {
+        reserve(other.size);
+        for (size_t i = 0ull; i < other.size; ++i)
+        {
+            construct_back(other[i]);
+        }
+    }
+
+    SoAVector(SoAVector&& other) noexcept :
+        arrays(std::exchange(other.arrays, Arrays{})), capacity(std::exchange(other.capacity, 0ull)),
+        size(std::exchange(other.size, 0ull))
+    {
+    }
+
+    SoAVector& operator=(const SoAVector& other)
+    {
+        if (this != &other)
+        {
+            SoAVector copy(other);
+            swap(*this, copy);
+        }
+        return *this;
+    }
+
+    SoAVector& operator=(SoAVector&& other) noexcept
+    {
+        SoAVector moved(std::move(other));
+        swap(*this, moved);
+        return *this;
+    }
+
+    ~SoAVector()
+    {
+        clear();
+        deallocate(arrays);
+    }
+
+    friend void swap(SoAVector& first, SoAVector& second) noexcept
+    {
+        using std::swap;
+        swap(first.arrays, second.arrays);
+        swap(first.capacity, second.capacity);
+        swap(first.size, second.size);
+    }
+
+    [[nodiscard]] size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    [[nodiscard]] size_t get_capacity() const noexcept
+    {
+        return capacity;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return size == 0ull;
+    }
+
+    void reserve(const size_t new_capacity)
+    {
+        if (capacity >= new_capacity)
+            return;
+
+        Arrays new_arrays = allocate(new_capacity);
+        replace_storage(new_arrays, new_capacity);
+    }
+
+    void shrink_to_fit()
+    {
+        if (capacity == size)
+            return;
+
+        Arrays new_arrays = size ? allocate(size) : Arrays{};
+        replace_storage(new_arrays, size);
+    }
+
+    void push_back(const value_type& row)
+    {
+        construct_back(row);
+    }
+
+    void push_back(value_type&& row)
+    {
+        construct_back(std::move(row));
+    }
+
+    // Takes one constructor argument per field.
+    template<typename... Args>
+    requires (sizeof...(Args) == sizeof...(Fields))
+    reference emplace_back(Args&&... fields)
+    {
+        construct_back(std::forward_as_tuple(std::forward<Args>(fields)...));
+        return (*this)[size - 1];
+    }
+
+    // Same as Vector::erase_swap: the last row is moved into `index`, the order is not kept.
+    void erase_swap(const size_t index)
+    {
+        const size_t last = size - 1;
+        if (index != last)
+        {
+            std::apply([index, last](auto*... array)
+            {
+                ((array[index] = std::move(array[last])), ...);
+            }, arrays);
+        }
+        pop_back();
+    }
+
+    void pop_back()
+    {
+        if (size)
+        {
+            --size;
+            destroy_row(size, sizeof...(Fields), Indices{});
+        }
+    }
+
+    void clear()
+    {
+        std::apply([this](auto*... array) { (std::destroy_n(array, size), ...); }, arrays);
+        size = 0ull;
+    }
+
+    // Unchecked access, use at() when the index is not known to be valid.
+    reference operator[](size_t index) noexcept
+    {
+        return row_at<reference>(index);
+    }
+
+    const_reference operator[](size_t index) const noexcept
+    {
+        return row_at<const_reference>(index);
+    }
+
+    reference at(size_t index)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("index out of bound");
+        }
+
+        return row_at<reference>(index);
+    }
+
+    const_reference at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("index out of bound");
+        }
+
+        return row_at<const_reference>(index);
+    }
+
+    // Contiguous view over a single field.
+    template<size_t I>
+    std::span<FieldType<I>> field() noexcept
+    {
+        return {std::get<I>(arrays), size};
+    }
+
+    template<size_t I>
+    std::span<const FieldType<I>> field() const noexcept
+    {
+        return {std::get<I>(arrays), size};
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0ull);
+    }
+
+    iterator end()
+    {
+        return iterator(this, size);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0ull);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, size);
+    }
+};
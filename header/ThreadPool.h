@@ -0,0 +1,67 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool: each worker owns a queue, pops its own tasks from the back (most recent,
+// still hot in cache) and steals from the front of the other queues when it runs dry.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Called from one of the pool's workers the task goes to that worker's queue,
+    // otherwise the queues are fed round-robin. Tasks must not throw.
+    void submit(Task task);
+
+    // Runs one pending task on the calling thread, if any. Lets a thread waiting on
+    // other tasks help instead of blocking, which also keeps nested parallelism from deadlocking.
+    bool try_run_pending_task();
+
+    [[nodiscard]] size_t get_thread_count() const noexcept
+    {
+        return threads.size();
+    }
+
+    // Process-wide pool sized to the hardware concurrency.
+    static ThreadPool& get_default();
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::atomic<size_t> next_queue{0ull};
+    std::atomic<size_t> pending_tasks{0ull};
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake_up;
+    bool is_stopping = false;
+
+    static thread_local ThreadPool* current_pool;
+    static thread_local size_t current_queue;
+
+    bool pop_task(size_t preferred_queue, Task& task);
+    void worker_loop(size_t index);
+};
@@ -0,0 +1,478 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <iostream>
+
+#include "Relocate.h"
+
+// List storing up to NodeCapacity_ elements per node in contiguous storage, so a traversal
+// touches one node per NodeCapacity_ elements instead of one per element.
+// Offers the cursor interface of List. A full node is split in two on insertion,
+// a node less than half full takes elements from its successor on erasure.
+template<typename T, size_t NodeCapacity_ = 16ull>
+class UnrolledList
+{
+    static_assert(NodeCapacity_ >= 2ull, "UnrolledList nodes must hold at least two elements");
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "UnrolledList elements must be nothrow move constructible, they are shifted inside and between nodes");
+
+    static constexpr size_t HalfCapacity = NodeCapacity_ / 2;
+
+    struct Node
+    {
+        alignas(T) std::byte storage[NodeCapacity_ * sizeof(T)];
+        size_t count = 0ull;
+        Node* prev = nullptr;
+        Node* next = nullptr;
+
+        T* data()
+        {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    Node* cursor_node = nullptr;
+    size_t cursor_index = 0ull;
+    size_t size = 0ull;
+
+    Node* new_node_after(Node* previous)
+    {
+        auto node = new Node();
+        node->prev = previous;
+        node->next = previous ? previous->next : head;
+
+        if (node->next)
+        {
+            node->next->prev = node;
+        }
+        else
+        {
+            tail = node;
+        }
+
+        if (previous)
+        {
+            previous->next = node;
+        }
+        else
+        {
+            head = node;
+        }
+        return node;
+    }
+
+    void delete_empty_node(Node* node) noexcept
+    {
+        if (node->prev)
+        {
+            node->prev->next = node->next;
+        }
+        else
+        {
+            head = node->next;
+        }
+
+        if (node->next)
+        {
+            node->next->prev = node->prev;
+        }
+        else
+        {
+            tail = node->prev;
+        }
+
+        delete node;
+    }
+
+    // Moves `count` elements starting at `first` inside `node` to `destination`.
+    // The ranges may overlap, `destination` is uninitialized storage.
+    static void shift(Node* node, const size_t first, const size_t destination, const size_t count) noexcept
+    {
+        T* data = node->data();
+        if (count == 0ull || first == destination)
+            return;
+
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            std::memmove(static_cast<void*>(data + destination), static_cast<const void*>(data + first), count * sizeof(T));
+        }
+        else if (destination < first)
+        {
+            for (size_t i = 0ull; i < count; ++i)
+            {
+                std::construct_at(data + destination + i, std::move(data[first + i]));
+                std::destroy_at(data + first + i);
+            }
+        }
+        else
+        {
+            for (size_t i = count; i > 0ull; --i)
+            {
+                std::construct_at(data + destination + i - 1, std::move(data[first + i - 1]));
+                std::destroy_at(data + first + i - 1);
+            }
+        }
+    }
+
+    // Appends `count` elements of `source` starting at `first` to `destination`, the cursor follows its element.
+    // The element count of `source` is left to the caller.
+    void move_elements(Node* source, const size_t first, const size_t count, Node* destination) noexcept
+    {
+        if (cursor_node == source && cursor_index >= first && cursor_index < first + count)
+        {
+            cursor_node = destination;
+            cursor_index = destination->count + cursor_index - first;
+        }
+
+        relocate(source->data() + first, count, destination->data() + destination->count);
+        destination->count += count;
+    }
+
+    template<typename... Args>
+    T* insert_at(Node* node, size_t position, Args&&... args)
+    {
+        T element(std::forward<Args>(args)...);
+
+        if (!node)
+        {
+            node = new_node_after(tail);
+            position = 0ull;
+        }
+        else if (node->count == NodeCapacity_ && position == NodeCapacity_ && node == tail)
+        {
+            node = new_node_after(node);
+            position = 0ull;
+        }
+        else if (node->count == NodeCapacity_)
+        {
+            Node* right = new_node_after(node);
+            move_elements(node, HalfCapacity, NodeCapacity_ - HalfCapacity, right);
+            node->count = HalfCapacity;
+
+            if (position > HalfCapacity)
+            {
+                node = right;
+                position -= HalfCapacity;
+            }
+        }
+
+        shift(node, position, position + 1, node->count - position);
+        std::construct_at(node->data() + position, std::move(element));
+        ++node->count;
+        ++size;
+
+        if (cursor_node == node && cursor_index >= position)
+        {
+            ++cursor_index;
+        }
+        if (!cursor_node && size == 1ull)
+        {
+            cursor_node = node;
+            cursor_index = 0ull;
+        }
+
+        return node->data() + position;
+    }
+
+    // A cursor on the erased element moves to the following one.
+    void erase_at(Node* node, const size_t position) noexcept
+    {
+        std::destroy_at(node->data() + position);
+        shift(node, position + 1, position, node->count - position - 1);
+        --node->count;
+        --size;
+
+        if (cursor_node == node && cursor_index > position)
+        {
+            --cursor_index;
+        }
+        else if (cursor_node == node && cursor_index == position && position == node->count)
+        {
+            cursor_node = node->next;
+            cursor_index = 0ull;
+        }
+
+        if (node->count == 0ull)
+        {
+            delete_empty_node(node);
+            return;
+        }
+
+        Node* next = node->next;
+        if (node->count >= HalfCapacity || !next)
+            return;
+
+        if (node->count + next->count <= NodeCapacity_)
+        {
+            move_elements(next, 0ull, next->count, node);
+            next->count = 0ull;
+            delete_empty_node(next);
+            return;
+        }
+
+        const size_t borrowed = HalfCapacity - node->count;
+        move_elements(next, 0ull, borrowed, node);
+        shift(next, borrowed, 0ull, next->count - borrowed);
+        next->count -= borrowed;
+
+        if (cursor_node == next)
+        {
+            cursor_index -= borrowed;
+        }
+    }
+
+    template<typename U>
+    class Iterator
+    {
+        friend class UnrolledList;
+        template<typename>
+        friend class Iterator;
+
+        Node* node = nullptr;
+        size_t index = 0ull;
+
+        Iterator(Node* node_, const size_t index_) : node(node_), index(index_)
+        {
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_cv_t<U>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        Iterator() = default;
+
+        // iterator converts to const_iterator.
+        template<typename V>
+        requires (std::is_const_v<U> && std::same_as<const V, U>)
+        Iterator(const Iterator<V>& other) : node(other.node), index(other.index)
+        {
+        }
+
+        U& operator*() const
+        {
+            return node->data()[index];
+        }
+
+        U* operator->() const
+        {
+            return node->data() + index;
+        }
+
+        bool operator==(const Iterator & other) const
+        {
+            return node == other.node && index == other.index;
+        }
+
+        Iterator& operator++()
+        {
+            if (++index == node->count)
+            {
+                node = node->next;
+                index = 0ull;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+    };
+
+public:
+    using value_type = T;
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    UnrolledList() = default;
+
+    UnrolledList(const UnrolledList& other)
+    {
+        for (auto it = other.begin(); it != other.end(); ++it)
+        {
+            push_back(*it);
+            if (it.node == other.cursor_node && it.index == other.cursor_index)
+            {
+                cursor_node = tail;
+                cursor_index = tail->count - 1;
+            }
+        }
+
+        if (!other.cursor_node)
+        {
+            cursor_node = nullptr;
+            cursor_index = 0ull;
+        }
+    }
+
+    UnrolledList(UnrolledList&& other) noexcept
+    {
+        swap(*this, other);
+    }
+
+    UnrolledList& operator=(UnrolledList other)
+    {
+        swap(*this, other);
+        return *this;
+    }
+
+    ~UnrolledList()
+    {
+        reset();
+    }
+
+    friend void swap(UnrolledList& first, UnrolledList& second) noexcept
+    {
+        using std::swap;
+        swap(first.head, second.head);
+        swap(first.tail, second.tail);
+        swap(first.cursor_node, second.cursor_node);
+        swap(first.cursor_index, second.cursor_index);
+        swap(first.size, second.size);
+    }
+
+    [[nodiscard]] size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return size == 0ull;
+    }
+
+    // Appending to a full last node starts a new one instead of splitting it, so nodes built by push_back are packed.
+    template<typename U = T>
+    T* push_back(U&& element)
+    {
+        return insert_at(tail, tail ? tail->count : 0ull, std::forward<U>(element));
+    }
+
+    template<typename U = T>
+    T* push_front(U&& element)
+    {
+        return insert_at(head, 0ull, std::forward<U>(element));
+    }
+
+    void pop_front()
+    {
+        if (head)
+        {
+            erase_at(head, 0ull);
+        }
+    }
+
+    void move_forward_cursor()
+    {
+        if (!cursor_node)
+        {
+            reset_cursor();
+        }
+        else if (cursor_index + 1 < cursor_node->count)
+        {
+            ++cursor_index;
+        }
+        else if (cursor_node->next)
+        {
+            cursor_node = cursor_node->next;
+            cursor_index = 0ull;
+        }
+    }
+
+    void reset_cursor()
+    {
+        cursor_node = head;
+        cursor_index = 0ull;
+    }
+
+    T* get_cursor()
+    {
+        return cursor_node ? cursor_node->data() + cursor_index : nullptr;
+    }
+
+    T* insert_after_cursor(T element)
+    {
+        if (!cursor_node)
+            return nullptr;
+
+        return insert_at(cursor_node, cursor_index + 1, std::move(element));
+    }
+
+    // Removes the element under the cursor, the cursor moves to the next element
+    // (or past the end when it was the last one). Returns false when there is no cursor.
+    bool erase_at_cursor()
+    {
+        if (!cursor_node)
+            return false;
+
+        erase_at(cursor_node, cursor_index);
+        return true;
+    }
+
+    void print_list(const std::string& list_name = "")
+    {
+        if (!list_name.empty())
+        {
+            std::cout << "UnrolledList " << list_name << " : ";
+        }
+
+        for (const auto& element : *this)
+        {
+            std::cout << element << " ";
+        }
+        std::cout << "\n";
+    }
+
+    void reset()
+    {
+        auto it = head;
+        while (it)
+        {
+            auto temp = it->next;
+            std::destroy_n(it->data(), it->count);
+            delete it;
+            it = temp;
+        }
+
+        head = nullptr;
+        tail = nullptr;
+        cursor_node = nullptr;
+        cursor_index = 0ull;
+        size = 0ull;
+    }
+
+    iterator begin()
+    {
+        return iterator(head, 0ull);
+    }
+
+    iterator end()
+    {
+        return iterator(nullptr, 0ull);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(head, 0ull);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr, 0ull);
+    }
+};
@@ -2,53 +2,207 @@
 // Created by y.grallan on 06/11/2025.
 //
 #pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
-template<typename T>
+#include "Relocate.h"
+
+template<typename T, size_t InlineCapacity_, typename Allocator_>
+class SmallVector;
+
+template<typename T, typename Allocator_ = std::allocator<T>>
 class Vector
 {
+    template<typename, size_t, typename>
+    friend class SmallVector;
+
+    using AllocatorTraits = std::allocator_traits<Allocator_>;
+
+    [[no_unique_address]] Allocator_ allocator;
     T* array = nullptr;
 
     size_t capacity = 0ull;
     size_t size = 0ull;
 
+    // Buffer embedded in a SmallVector, never handed back to the allocator.
+    T* inline_array = nullptr;
+    size_t inline_capacity = 0ull;
+
+    T* allocate(const size_t count)
+    {
+        return AllocatorTraits::allocate(allocator, count);
+    }
+
+    void deallocate(T* buffer, const size_t count) noexcept
+    {
+        if (buffer && buffer != inline_array)
+        {
+            AllocatorTraits::deallocate(allocator, buffer, count);
+        }
+    }
+
     void reserve_impl(const size_t new_capacity,const bool is_from_shrink_to_fit)
     {
         if (capacity >= new_capacity && !is_from_shrink_to_fit)
             return;
 
-        T* new_array = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+        const bool fits_inline = is_from_shrink_to_fit && new_capacity <= inline_capacity;
+        T* new_array = fits_inline ? inline_array : allocate(new_capacity);
+        if (new_array == array)
+            return;
+
+        try
+        {
+            relocate(array, size, new_array);
+        }
+        catch (...)
+        {
+            deallocate(new_array, new_capacity);
+            throw;
+        }
+
+        deallocate(array, capacity);
+
+        array = new_array;
+        capacity = fits_inline ? inline_capacity : new_capacity;
+    }
+
+    [[nodiscard]] bool is_inline() const noexcept
+    {
+        return inline_array && array == inline_array;
+    }
+
+    void reset_to_inline_storage() noexcept
+    {
+        array = inline_array;
+        capacity = inline_capacity;
+        size = 0ull;
+    }
+
+    // Moves the content of `other` into this empty vector: a heap buffer is stolen,
+    // inline elements or elements owned by a different allocator are relocated one by one.
+    void take_elements_from(Vector& other)
+    {
+        if (other.is_inline() || other.capacity == 0ull || allocator != other.allocator)
+        {
+            reserve(other.size);
+            relocate(other.array, other.size, array);
+            size = other.size;
+            other.size = 0ull;
+            return;
+        }
+
+        deallocate(array, capacity);
+        array = other.array;
+        capacity = other.capacity;
+        size = other.size;
+        other.reset_to_inline_storage();
+    }
+
+    void append_copy_of(const Vector& other)
+    {
+        append_range(std::ranges::subrange(other.array, other.array + other.size));
+    }
+
+    void release_storage() noexcept
+    {
+        clear();
+        deallocate(array, capacity);
+        reset_to_inline_storage();
+    }
+
+    Vector(T* inline_storage, const size_t inline_storage_capacity, const Allocator_& allocator_) noexcept :
+        allocator(allocator_), array(inline_storage), capacity(inline_storage_capacity),
+        inline_array(inline_storage), inline_capacity(inline_storage_capacity)
+    {
+    }
+
+    [[nodiscard]] size_t grown_capacity(const size_t required_capacity) const noexcept
+    {
+        return std::max(required_capacity, capacity * 2);
+    }
+
+    // The new element is constructed before the old buffer is released, so arguments
+    // referring to elements of this vector stay valid.
+    template<typename... Args>
+    T& grow_and_emplace_back(Args&&... args)
+    {
+        const size_t new_capacity = grown_capacity(size + 1);
+        T* new_array = allocate(new_capacity);
+
+        try
+        {
+            std::construct_at(new_array + size, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(new_array, new_capacity);
+            throw;
+        }
 
-        for (size_t i = 0; i < size; ++i)
+        try
+        {
+            relocate(array, size, new_array);
+        }
+        catch (...)
         {
-            new (&new_array[i]) T(std::move(array[i]));
+            std::destroy_at(new_array + size);
+            deallocate(new_array, new_capacity);
+            throw;
         }
 
-        ::operator delete[](array);
+        deallocate(array, capacity);
 
         array = new_array;
         capacity = new_capacity;
+        return array[size++];
     }
 
+    // Contiguous iterator over the elements: std::ranges algorithms, std::span and std::to_address
+    // see the underlying array directly.
     template<typename U = T>
-    class Iterator : public std::iterator<std::random_access_iterator_tag, T>
+    class Iterator
     {
-        using difference_type = std::ptrdiff_t;
-        friend class Vector<T>;
+        friend class Vector;
+        template<typename>
+        friend class Iterator;
 
         U* ptr = nullptr;
     public:
+        using iterator_concept = std::contiguous_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<U>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        Iterator() = default;
+
         explicit Iterator(U* ptr_) : ptr(ptr_)
         {
         }
 
-        U& operator*()
+        // iterator converts to const_iterator.
+        template<typename V>
+        requires (std::is_const_v<U> && std::same_as<const V, U>)
+        Iterator(const Iterator<V>& other) : ptr(other.ptr)
+        {
+        }
+
+        U& operator*() const
         {
             return *ptr;
         }
 
-        U* operator->()
+        U* operator->() const
         {
             return ptr;
         }
@@ -58,11 +212,6 @@ class Vector
             return other.ptr == ptr;
         }
 
-        bool operator!=(const Iterator & other) const
-        {
-            return !(other == *this);
-        }
-
         Iterator& operator++()
         {
             ++ptr;
@@ -99,6 +248,10 @@ class Vector
             return tmp;
         }
 
+        friend Iterator operator+(difference_type offset, const Iterator& iterator) {
+            return iterator + offset;
+        }
+
         Iterator& operator-=(difference_type offset) {
             ptr -= offset;
             return *this;
@@ -111,7 +264,7 @@ class Vector
         }
 
         difference_type operator-(const Iterator& other) const {
-            return ptr - other.m_ptr;
+            return ptr - other.ptr;
         }
 
         U& operator[](difference_type offset) const {
@@ -122,31 +275,137 @@ class Vector
     };
 
 public:
-    Vector()
+    using value_type = T;
+    using allocator_type = Allocator_;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    Vector() : Vector(Allocator_())
+    {
+    }
+
+    explicit Vector(const Allocator_& allocator_) : allocator(allocator_)
     {
         reserve(3);
     }
-    Vector(const Vector& other)
+
+    Vector(std::initializer_list<T> list, const Allocator_& allocator_ = Allocator_()) : allocator(allocator_)
+    {
+        append_range(list);
+    }
+
+    Vector(const Vector& other) : Vector(other, AllocatorTraits::select_on_container_copy_construction(other.allocator))
+    {
+    }
+
+    // Allocates exactly the size of `other` once, then copy-constructs the elements in place.
+    Vector(const Vector& other, const Allocator_& allocator_) : allocator(allocator_)
+    {
+        reserve(other.size);
+        append_copy_of(other);
+    }
+
+    // Steals the buffer of `other`, which is left empty without storage, and never allocates.
+    // A SmallVector goes through the overload below, unless it is moved through a Vector& while
+    // its elements are inline: they are then relocated into a new allocation, and failing it terminates.
+    Vector(Vector&& other) noexcept : allocator(std::move(other.allocator))
+    {
+        take_elements_from(other);
+    }
+
+    // Steals a heap buffer like the constructor above, but elements still in the inline buffer
+    // are relocated into a new allocation, which may throw.
+    template<size_t InlineCapacity_>
+    Vector(SmallVector<T, InlineCapacity_, Allocator_>&& other) : allocator(static_cast<Vector&>(other).allocator)
+    {
+        take_elements_from(other);
+    }
+
+    ~Vector()
     {
-        reserve(other.capacity);
-        for (size_t i = 0; i < other.size; i++)
+        release_storage();
+    }
+
+    // The copy is made with this vector's allocator so assigning never changes where the storage comes from.
+    Vector& operator=(const Vector& other)
+    {
+        if (this != &other)
+        {
+            Vector copy(other, allocator);
+            swap(*this, copy);
+        }
+        return *this;
+    }
+
+    // With an allocator that neither propagates nor always compares equal, elements owned by
+    // a different allocator are relocated one by one instead of stealing the buffer.
+    Vector& operator=(Vector&& other) noexcept(AllocatorTraits::propagate_on_container_move_assignment::value ||
+                                               AllocatorTraits::is_always_equal::value)
+    {
+        if (this != &other)
         {
-            push_back(other[i]);
+            release_storage();
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+            {
+                allocator = std::move(other.allocator);
+            }
+            take_elements_from(other);
         }
+        return *this;
     }
 
-    Vector& operator=(Vector other)
+    // Same as the move assignment above, without its noexcept: inline elements need a new allocation.
+    template<size_t InlineCapacity_>
+    Vector& operator=(SmallVector<T, InlineCapacity_, Allocator_>&& other)
     {
-        swap(*this, other);
+        Vector& source = other;
+        if (this != &source)
+        {
+            release_storage();
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+            {
+                allocator = source.allocator;
+            }
+            take_elements_from(source);
+        }
         return *this;
     }
 
-    friend void swap(Vector& first, Vector& second) noexcept
+    // Heap buffers are exchanged in O(1). A SmallVector using its inline buffer, or two vectors
+    // with unequal non-propagating allocators, relocate their elements instead.
+    friend void swap(Vector& first, Vector& second)
     {
-        using std::swap;
-        swap(first.array, second.array);
-        swap(first.capacity, second.capacity);
-        swap(first.size, second.size);
+        constexpr bool propagate_allocator = AllocatorTraits::propagate_on_container_swap::value;
+        const bool same_storage = propagate_allocator || first.allocator == second.allocator;
+
+        if (!first.is_inline() && !second.is_inline() && same_storage)
+        {
+            using std::swap;
+            if constexpr (propagate_allocator)
+            {
+                swap(first.allocator, second.allocator);
+            }
+            swap(first.array, second.array);
+            swap(first.capacity, second.capacity);
+            swap(first.size, second.size);
+            return;
+        }
+
+        Vector temporary(nullptr, 0ull, first.allocator);
+        temporary.take_elements_from(first);
+        first.take_elements_from(second);
+        second.take_elements_from(temporary);
+    }
+
+    [[nodiscard]] Allocator_ get_allocator() const noexcept
+    {
+        return allocator;
     }
 
     [[nodiscard]] size_t get_size() const noexcept
@@ -171,25 +430,151 @@ public:
 
     template<typename U = T>
     void push_back(U&& element)
+    {
+        emplace_back(std::forward<U>(element));
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
     {
         if (size >= capacity)
         {
-            reserve(capacity * 2);
+            return grow_and_emplace_back(std::forward<Args>(args)...);
+        }
+
+        std::construct_at(array + size, std::forward<Args>(args)...);
+        return array[size++];
+    }
+
+    // Sized and forward ranges are counted first so the storage grows at most once,
+    // then the elements are constructed in bulk at the end of the vector.
+    // The range must not refer to elements of this vector.
+    template<std::ranges::input_range R>
+    void append_range(R&& range)
+    {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>)
+        {
+            const auto count = static_cast<size_t>(std::ranges::distance(range));
+            if (size + count > capacity)
+            {
+                reserve(grown_capacity(size + count));
+            }
+
+            std::ranges::uninitialized_copy_n(std::ranges::begin(range), count, array + size, array + size + count);
+            size += count;
+        }
+        else
+        {
+            for (auto&& element : range)
+            {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
         }
-        array[size++] = std::forward<U>(element);
     }
 
+    // Appends [first, last) with a single allocation, then rotates it into place.
+    template<std::input_iterator It, std::sentinel_for<It> Sentinel>
+    Iterator<T> insert(Iterator<T> position, It first, Sentinel last)
+    {
+        const size_t index = position.ptr - array;
+        const size_t previous_size = size;
+
+        append_range(std::ranges::subrange(std::move(first), std::move(last)));
+        std::rotate(array + index, array + previous_size, array + size);
+
+        return Iterator<T>(array + index);
+    }
+
+    // Removes the element at `index` by moving the last element into its place, the order is not kept.
     void erase_swap(const size_t index)
     {
-        array[index].~T();
-        std::swap(array[index],array[--size]);
+        const size_t last = size - 1;
+        if (index != last)
+        {
+            array[index] = std::move(array[last]);
+        }
+        std::destroy_at(array + last);
+        size = last;
+    }
+
+    // Removes [first, last) and shifts the following elements down, keeping their order.
+    Iterator<T> erase(Iterator<T> first, Iterator<T> last)
+    {
+        T* const begin_removed = first.ptr;
+        T* const end_removed = last.ptr;
+        if (begin_removed == end_removed)
+            return first;
+
+        T* const new_end = std::move(end_removed, array + size, begin_removed);
+        std::destroy(new_end, array + size);
+        size = new_end - array;
+
+        return first;
+    }
+
+    // Removes every element matching `predicate` in a single pass, keeping the order of the others.
+    // Returns the number of removed elements.
+    template<typename Predicate>
+    size_t erase_if(Predicate predicate)
+    {
+        size_t kept = 0ull;
+        for (size_t i = 0ull; i < size; ++i)
+        {
+            if (predicate(std::as_const(array[i])))
+                continue;
+
+            if (kept != i)
+            {
+                array[kept] = std::move(array[i]);
+            }
+            ++kept;
+        }
+
+        const size_t removed = size - kept;
+        std::destroy(array + kept, array + size);
+        size = kept;
+        return removed;
+    }
+
+    // Same as erase_if without keeping the order: each hole is filled with the last kept element,
+    // so an element is moved at most once and the predicate is called once per element.
+    template<typename Predicate>
+    size_t erase_swap_if(Predicate predicate)
+    {
+        size_t kept = 0ull;
+        size_t end = size;
+        while (kept < end)
+        {
+            if (!predicate(std::as_const(array[kept])))
+            {
+                ++kept;
+                continue;
+            }
+
+            do
+            {
+                --end;
+            }
+            while (end > kept && predicate(std::as_const(array[end])));
+
+            if (end == kept)
+                break;
+
+            array[kept] = std::move(array[end]);
+            ++kept;
+        }
+
+        const size_t removed = size - kept;
+        std::destroy(array + kept, array + size);
+        size = kept;
+        return removed;
     }
 
     void pop_back()
     {
         if (size)
         {
-            array[size--].~T();
+            array[--size].~T();
         }
     }
 
@@ -207,33 +592,48 @@ public:
         if (count == size)
             return;
 
-        const int current_size = size;
         if (count > size)
         {
-            for (int i = 0; i < count - current_size; ++i)
+            if (count > capacity)
             {
-                push_back(initializer);
+                // `initializer` may be an element of this vector, it is copied before the old buffer is released.
+                const T value(initializer);
+                reserve(grown_capacity(count));
+                std::uninitialized_fill(array + size, array + count, value);
+            }
+            else
+            {
+                std::uninitialized_fill(array + size, array + count, initializer);
             }
         }
         else
         {
-            for (int i = current_size - 1; i < count - 1; ++i)
-            {
-                array[i].~T();
-            }
+            std::destroy(array + count, array + size);
         }
         size = count;
     }
 
 
+    // A SmallVector whose elements fit back in its inline buffer moves back into it.
     void shrink_to_fit()
     {
         reserve_impl(size, true);
     }
 
-    T& operator[](size_t index)
+    // Unchecked access, use at() when the index is not known to be valid.
+    T& operator[](size_t index) noexcept
+    {
+        return array[index];
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return array[index];
+    }
+
+    T& at(size_t index)
     {
-        if (index >= size || is_empty())
+        if (index >= size)
         {
             throw std::out_of_range("index out of bound");
         }
@@ -241,6 +641,36 @@ public:
         return array[index];
     }
 
+    const T& at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("index out of bound");
+        }
+
+        return array[index];
+    }
+
+    [[nodiscard]] T* data() noexcept
+    {
+        return array;
+    }
+
+    [[nodiscard]] const T* data() const noexcept
+    {
+        return array;
+    }
+
+    operator std::span<T>() noexcept
+    {
+        return {array, size};
+    }
+
+    operator std::span<const T>() const noexcept
+    {
+        return {array, size};
+    }
+
     Iterator<T> begin()
     {
         return Iterator(array);
@@ -261,3 +691,9 @@ public:
         return Iterator(array + size);
     }
 };
+
+namespace pmr
+{
+    template<typename T>
+    using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>>;
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Scanning kernels over the contiguous storage of a Vector of arithmetic values.
+// float, double and int32_t go through SIMD kernels picked at runtime (SSE2, AVX2 or AVX-512),
+// every other arithmetic type uses the scalar versions below.
+namespace VectorAlgorithms
+{
+    enum class InstructionSet
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    // Widest instruction set supported by both the CPU and this build.
+    [[nodiscard]] InstructionSet detected_instruction_set() noexcept;
+
+    [[nodiscard]] InstructionSet active_instruction_set() noexcept;
+
+    // Forces a narrower instruction set (e.g. to compare kernels), clamped to the detected one.
+    // Returns the instruction set actually selected.
+    InstructionSet set_instruction_set(InstructionSet instruction_set) noexcept;
+
+    [[nodiscard]] const char* to_string(InstructionSet instruction_set) noexcept;
+
+    template<typename T>
+    concept Arithmetic = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+    // Integers are summed in 64 bits so a column of int32_t doesn't overflow.
+    template<Arithmetic T>
+    using SumType = std::conditional_t<std::is_floating_point_v<T>, T,
+        std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+    namespace scalar
+    {
+        template<Arithmetic T>
+        size_t find(const T* data, const size_t length, const T value) noexcept
+        {
+            for (size_t i = 0ull; i < length; ++i)
+            {
+                if (data[i] == value)
+                {
+                    return i;
+                }
+            }
+            return length;
+        }
+
+        template<Arithmetic T>
+        size_t count(const T* data, const size_t length, const T value) noexcept
+        {
+            size_t result = 0ull;
+            for (size_t i = 0ull; i < length; ++i)
+            {
+                result += data[i] == value;
+            }
+            return result;
+        }
+
+        // `length` must be greater than 0.
+        template<Arithmetic T>
+        std::pair<T, T> minmax(const T* data, const size_t length) noexcept
+        {
+            T minimum = data[0];
+            T maximum = data[0];
+            for (size_t i = 1ull; i < length; ++i)
+            {
+                minimum = data[i] < minimum ? data[i] : minimum;
+                maximum = data[i] > maximum ? data[i] : maximum;
+            }
+            return {minimum, maximum};
+        }
+
+        template<Arithmetic T>
+        T min(const T* data, const size_t length) noexcept
+        {
+            return minmax(data, length).first;
+        }
+
+        template<Arithmetic T>
+        T max(const T* data, const size_t length) noexcept
+        {
+            return minmax(data, length).second;
+        }
+
+        template<Arithmetic T>
+        SumType<T> sum(const T* data, const size_t length) noexcept
+        {
+            SumType<T> result{};
+            for (size_t i = 0ull; i < length; ++i)
+            {
+                result += static_cast<SumType<T>>(data[i]);
+            }
+            return result;
+        }
+
+        template<Arithmetic T>
+        SumType<T> dot(const T* first, const T* second, const size_t length) noexcept
+        {
+            SumType<T> result{};
+            for (size_t i = 0ull; i < length; ++i)
+            {
+                result += static_cast<SumType<T>>(first[i]) * static_cast<SumType<T>>(second[i]);
+            }
+            return result;
+        }
+
+        template<Arithmetic T>
+        void fill(T* data, const size_t length, const T value) noexcept
+        {
+            for (size_t i = 0ull; i < length; ++i)
+            {
+                data[i] = value;
+            }
+        }
+    }
+
+    namespace detail
+    {
+        template<typename T>
+        concept SimdElement = std::same_as<T, float> || std::same_as<T, double> || std::same_as<T, int32_t>;
+
+        // Defined in VectorAlgorithms.cpp, dispatching to the active instruction set.
+        template<SimdElement T> size_t find(const T* data, size_t length, T value) noexcept;
+        template<SimdElement T> size_t count(const T* data, size_t length, T value) noexcept;
+        template<SimdElement T> std::pair<T, T> minmax(const T* data, size_t length) noexcept;
+        template<SimdElement T> SumType<T> sum(const T* data, size_t length) noexcept;
+        template<SimdElement T> SumType<T> dot(const T* first, const T* second, size_t length) noexcept;
+        template<SimdElement T> void fill(T* data, size_t length, T value) noexcept;
+
+        template<typename T, typename Allocator_>
+        void throw_if_empty(const Vector<T, Allocator_>& vector)
+        {
+            if (vector.is_empty())
+            {
+                throw std::out_of_range("vector is empty");
+            }
+        }
+    }
+
+    // Index of the first element equal to `value`, or get_size() when there is none.
+    template<Arithmetic T, typename Allocator_>
+    size_t find(const Vector<T, Allocator_>& vector, const std::type_identity_t<T> value)
+    {
+        if constexpr (detail::SimdElement<T>)
+            return detail::find(vector.data(), vector.get_size(), value);
+        else
+            return scalar::find(vector.data(), vector.get_size(), value);
+    }
+
+    template<Arithmetic T, typename Allocator_>
+    size_t count(const Vector<T, Allocator_>& vector, const std::type_identity_t<T> value)
+    {
+        if constexpr (detail::SimdElement<T>)
+            return detail::count(vector.data(), vector.get_size(), value);
+        else
+            return scalar::count(vector.data(), vector.get_size(), value);
+    }
+
+    template<Arithmetic T, typename Allocator_>
+    std::pair<T, T> minmax(const Vector<T, Allocator_>& vector)
+    {
+        detail::throw_if_empty(vector);
+        if constexpr (detail::SimdElement<T>)
+            return detail::minmax(vector.data(), vector.get_size());
+        else
+            return scalar::minmax(vector.data(), vector.get_size());
+    }
+
+    template<Arithmetic T, typename Allocator_>
+    T min(const Vector<T, Allocator_>& vector)
+    {
+        return minmax(vector).first;
+    }
+
+    template<Arithmetic T, typename Allocator_>
+    T max(const Vector<T, Allocator_>& vector)
+    {
+        return minmax(vector).second;
+    }
+
+    template<Arithmetic T, typename Allocator_>
+    SumType<T> sum(const Vector<T, Allocator_>& vector)
+    {
+        if constexpr (detail::SimdElement<T>)
+            return detail::sum(vector.data(), vector.get_size());
+        else
+            return scalar::sum(vector.data(), vector.get_size());
+    }
+
+    template<Arithmetic T, typename FirstAllocator_, typename SecondAllocator_>
+    SumType<T> dot(const Vector<T, FirstAllocator_>& first, const Vector<T, SecondAllocator_>& second)
+    {
+        if (first.get_size() != second.get_size())
+        {
+            throw std::invalid_argument("vectors must have the same size");
+        }
+
+        if constexpr (detail::SimdElement<T>)
+            return detail::dot(first.data(), second.data(), first.get_size());
+        else
+            return scalar::dot(first.data(), second.data(), first.get_size());
+    }
+
+    // Assigns `value` to every element already in the vector.
+    template<Arithmetic T, typename Allocator_>
+    void fill(Vector<T, Allocator_>& vector, const std::type_identity_t<T> value)
+    {
+        if constexpr (detail::SimdElement<T>)
+            detail::fill(vector.data(), vector.get_size(), value);
+        else
+            scalar::fill(vector.data(), vector.get_size(), value);
+    }
+}
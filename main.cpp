@@ -1,13 +1,21 @@
 ﻿#include <iostream>
 #include <string>
 #include <format>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "Deque.h"
 #include "Vector.h"
+#include "SmallVector.h"
+#include "VectorAlgorithms.h"
 #include "List.h"
 #include "HashMap.h"
 #include "QuadTree.h"
 #include "Colony.h"
+#include "MPSCQueue.h"
 
 namespace DequeMain
 {
@@ -72,11 +80,205 @@ namespace VectorMain
         {
             std::cout << a_  << " ";
         }
+        std::cout << "\n";
+
+        // Growing from one of its own elements must copy it before the old buffer is released.
+        Vector<std::string> words;
+        words.push_back("aliased initializer");
+        words.shrink_to_fit();
+        words.resize(words.get_capacity() + 1, words[0]);
+        for (const auto& word : words)
+        {
+            if (word != "aliased initializer")
+            {
+                throw std::logic_error("resize read its initializer from a released buffer");
+            }
+        }
+        std::cout << "Vector resize from own element : ok\n";
 
         return 0;
     }
 }
 
+namespace VectorAllocationMain
+{
+    inline size_t allocation_count = 0ull;
+
+    template<typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(const size_t count)
+        {
+            ++allocation_count;
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T* pointer, const size_t count) noexcept
+        {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        friend bool operator==(const CountingAllocator&, const CountingAllocator&) = default;
+    };
+
+    template<typename Function>
+    void expect_allocations(const std::string& name, const size_t minimum, const size_t maximum, Function function)
+    {
+        const size_t before = allocation_count;
+        function();
+        const size_t count = allocation_count - before;
+        if (count < minimum || count > maximum)
+        {
+            throw std::logic_error(name + " allocated " + std::to_string(count) + " times");
+        }
+        std::cout << name << " : " << count << " allocation(s)\n";
+    }
+
+    void run()
+    {
+        using CountedVector = Vector<std::string, CountingAllocator<std::string>>;
+        using CountedSmallVector = SmallVector<std::string, 4, CountingAllocator<std::string>>;
+
+        CountedVector source;
+        for (int i = 0; i < 100; ++i)
+        {
+            source.push_back(std::to_string(i));
+        }
+
+        expect_allocations("Vector copy", 1, 1, [&] { CountedVector copy(source); });
+
+        CountedVector moved_from(source);
+        expect_allocations("Vector move construction", 0, 0, [&] { CountedVector moved(std::move(moved_from)); });
+
+        CountedVector assigned;
+        CountedVector assigned_from(source);
+        expect_allocations("Vector move assignment", 0, 0, [&] { assigned = std::move(assigned_from); });
+
+        std::vector<std::string> sized(1000, "element");
+        CountedVector appended;
+        expect_allocations("Vector append_range of a sized range", 0, 1, [&] { appended.append_range(sized); });
+
+        CountedSmallVector small_inline{"a", "b", "c"};
+        expect_allocations("SmallVector inline move", 0, 0, [&] { CountedSmallVector moved(std::move(small_inline)); });
+
+        CountedSmallVector small_heap;
+        for (int i = 0; i < 10; ++i)
+        {
+            small_heap.push_back(std::to_string(i));
+        }
+        expect_allocations("SmallVector heap move", 0, 0, [&] { CountedSmallVector moved(std::move(small_heap)); });
+
+        CountedSmallVector spilled_inline{"a", "b", "c"};
+        expect_allocations("Vector from inline SmallVector", 1, 1, [&] { CountedVector moved(std::move(spilled_inline)); });
+    }
+}
+
+namespace SmallVectorMain
+{
+    void run()
+    {
+        SmallVector<int, 4> a;
+        for (int i = 0; i < 4; ++i)
+        {
+            a.emplace_back(i);
+        }
+        std::cout << "Inline : " << a.is_small() << "\n";
+
+        a.push_back(4);
+        std::cout << "Inline after spill : " << a.is_small() << "\n";
+
+        SmallVector<int, 4> b = std::move(a);
+        for (const auto& element : b)
+        {
+            std::cout << element << " ";
+        }
+        std::cout << "\n";
+    }
+}
+
+namespace VectorAlgorithmsMain
+{
+    using VectorAlgorithms::InstructionSet;
+
+    template<typename T>
+    void expect_equal(const T& actual, const T& expected, const std::string& what, const InstructionSet instruction_set, const size_t length)
+    {
+        if (actual != expected)
+        {
+            throw std::logic_error(std::string(VectorAlgorithms::to_string(instruction_set)) + " " + what +
+                                   " differs from the scalar kernel at length " + std::to_string(length));
+        }
+    }
+
+    // Small integral values keep floating-point sums exact whatever order the lanes add them in.
+    // The extremes and the searched value sit in the last element so the tail loops are exercised.
+    template<typename T>
+    void check_kernels(const InstructionSet instruction_set, std::mt19937& random)
+    {
+        for (const size_t length : {0ull, 1ull, 15ull, 17ull, 63ull, 65ull})
+        {
+            Vector<T> first;
+            Vector<T> second;
+            for (size_t i = 0; i < length; ++i)
+            {
+                first.push_back(static_cast<T>(static_cast<int>(random() % 41) - 20));
+                second.push_back(static_cast<T>(static_cast<int>(random() % 41) - 20));
+            }
+
+            for (const bool extreme_tail : {false, true})
+            {
+                if (extreme_tail && length)
+                {
+                    first[length - 1] = static_cast<T>(length % 2 ? 1000 : -1000);
+                }
+
+                const T* data = first.data();
+                const T searched = length ? first[length - 1] : T(7);
+                expect_equal(VectorAlgorithms::find(first, searched), VectorAlgorithms::scalar::find(data, length, searched), "find", instruction_set, length);
+                expect_equal(VectorAlgorithms::find(first, T(99)), VectorAlgorithms::scalar::find(data, length, T(99)), "find of a missing value", instruction_set, length);
+                expect_equal(VectorAlgorithms::count(first, T(3)), VectorAlgorithms::scalar::count(data, length, T(3)), "count", instruction_set, length);
+                expect_equal(VectorAlgorithms::sum(first), VectorAlgorithms::scalar::sum(data, length), "sum", instruction_set, length);
+                expect_equal(VectorAlgorithms::dot(first, second), VectorAlgorithms::scalar::dot(data, second.data(), length), "dot", instruction_set, length);
+                if (length)
+                {
+                    expect_equal(VectorAlgorithms::minmax(first), VectorAlgorithms::scalar::minmax(data, length), "minmax", instruction_set, length);
+                }
+            }
+
+            VectorAlgorithms::fill(second, T(5));
+            expect_equal(VectorAlgorithms::count(second, T(5)), length, "fill", instruction_set, length);
+        }
+    }
+
+    // Every kernel the CPU can run is compared with the scalar one on lengths around the register widths.
+    void run()
+    {
+        const InstructionSet detected = VectorAlgorithms::detected_instruction_set();
+        std::mt19937 random(5);
+        for (const auto instruction_set : {InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512})
+        {
+            if (static_cast<int>(instruction_set) > static_cast<int>(detected))
+                break;
+
+            VectorAlgorithms::set_instruction_set(instruction_set);
+            check_kernels<float>(instruction_set, random);
+            check_kernels<double>(instruction_set, random);
+            check_kernels<int32_t>(instruction_set, random);
+            std::cout << "Vector algorithms " << VectorAlgorithms::to_string(instruction_set) << " : ok\n";
+        }
+        VectorAlgorithms::set_instruction_set(detected);
+    }
+}
+
 namespace ListMain
 {
     int run()
@@ -140,6 +342,22 @@ namespace HashMapMain
             std::cout << "Key : " << key << ' '  << "Value : "<< value << '\n';
         }
 
+        // A max load factor below 1 needs several splits per insert, the table must never exceed it.
+        for (const float max_load_factor : {0.25f, 0.5f, 0.75f})
+        {
+            ClosedHashMap::HashMap<int, int> sparse;
+            sparse.set_max_load_factor(max_load_factor);
+            for (int i = 0; i < 100000; ++i)
+            {
+                sparse.insert(i, i);
+                if (sparse.get_load_factor() > max_load_factor)
+                {
+                    throw std::logic_error("load factor " + std::to_string(sparse.get_load_factor()) + " above its maximum " + std::to_string(max_load_factor));
+                }
+            }
+        }
+        std::cout << "\nClosed Hash map max load factor : ok\n";
+
 
         std::cout << "\n\n----- Open Hash map -----\n\n";
 
@@ -172,6 +390,42 @@ namespace HashMapMain
     }
 }
 
+namespace RobinHoodHashMapMain
+{
+    // Erasing while iterating must visit every key once, even when a backward shift wraps around
+    // the end of the table and brings elements from its start.
+    void run()
+    {
+        for (unsigned seed = 0; seed < 2000; ++seed)
+        {
+            std::mt19937 random(seed);
+            RobinHoodHashMap::HashMap<int, int> map;
+            const int count = 3 + static_cast<int>(random() % 20);
+            for (int i = 0; i < count; ++i)
+            {
+                map.insert(static_cast<int>(random()), i);
+            }
+
+            std::map<int, int> visits;
+            const size_t previous_size = map.get_size();
+            for (auto it = map.begin(); it != map.end();)
+            {
+                if (++visits[it->first] > 1)
+                {
+                    throw std::logic_error("key visited twice, seed " + std::to_string(seed));
+                }
+                it = random() % 2 ? map.erase(it) : std::next(it);
+            }
+
+            if (visits.size() != previous_size)
+            {
+                throw std::logic_error("key skipped, seed " + std::to_string(seed));
+            }
+        }
+        std::cout << "Robin Hood erase loop : ok\n";
+    }
+}
+
 namespace QuadTreeMain
 {
     struct Player
@@ -259,6 +513,91 @@ namespace ColonyMain
     }
 }
 
+namespace MPSCQueueMain
+{
+    constexpr int producer_count = 4;
+    constexpr int push_count = 20000;
+
+    struct Message : MPSCQueueHook<>
+    {
+        int producer = 0;
+        int sequence = 0;
+    };
+
+    // Messages of one producer must come out in the order it pushed them, and each exactly once.
+    void check(std::vector<int>& expected, const int producer, const int sequence)
+    {
+        if (expected[producer]++ != sequence)
+        {
+            throw std::logic_error("producer " + std::to_string(producer) + " out of order at " + std::to_string(sequence));
+        }
+    }
+
+    template<typename Producer, typename Consumer>
+    void run_producers(const std::string& name, Producer producer, Consumer consume)
+    {
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producer_count; ++p)
+        {
+            producers.emplace_back(producer, p);
+        }
+
+        std::vector<int> expected(producer_count, 0);
+        int received = 0;
+        while (received < producer_count * push_count)
+        {
+            received += static_cast<int>(consume(expected));
+        }
+
+        for (auto& thread : producers)
+        {
+            thread.join();
+        }
+        std::cout << name << " : " << received << " messages from " << producer_count << " producers in order\n";
+    }
+
+    void run()
+    {
+        MPSCQueue<std::pair<int, int>> queue;
+        run_producers("MPSC Queue",
+            [&](const int producer)
+            {
+                for (int i = 0; i < push_count; ++i)
+                {
+                    queue.push(std::pair(producer, i));
+                }
+            },
+            [&](std::vector<int>& expected)
+            {
+                return queue.drain([&](const std::pair<int, int>& message) { check(expected, message.first, message.second); });
+            });
+
+        std::vector<std::vector<Message>> messages(producer_count, std::vector<Message>(push_count));
+        IntrusiveMPSCQueue<Message> intrusive_queue;
+        run_producers("Intrusive MPSC Queue",
+            [&](const int producer)
+            {
+                for (int i = 0; i < push_count; ++i)
+                {
+                    Message& message = messages[producer][i];
+                    message.producer = producer;
+                    message.sequence = i;
+                    intrusive_queue.push(message);
+                }
+            },
+            [&](std::vector<int>& expected)
+            {
+                size_t count = intrusive_queue.drain([&](const Message& message) { check(expected, message.producer, message.sequence); });
+                while (Message* message = intrusive_queue.try_pop())
+                {
+                    check(expected, message->producer, message->sequence);
+                    ++count;
+                }
+                return count;
+            });
+    }
+}
+
 int main()
 {
     std::cout << "\n";
@@ -266,13 +605,23 @@ int main()
     std::cout << "\n";
     VectorMain::run();
     std::cout << "\n";
+    SmallVectorMain::run();
+    std::cout << "\n";
+    VectorAllocationMain::run();
+    std::cout << "\n";
+    VectorAlgorithmsMain::run();
+    std::cout << "\n";
     ListMain::run();
     std::cout << "\n";
     HashMapMain::run();
     std::cout << "\n";
+    RobinHoodHashMapMain::run();
+    std::cout << "\n";
     QuadTreeMain::run();
     std::cout << "\n";
     ColonyMain::run();
+    std::cout << "\n";
+    MPSCQueueMain::run();
 
 
 
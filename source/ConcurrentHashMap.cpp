@@ -0,0 +1,6 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "../header/ConcurrentHashMap.h"
\ No newline at end of file
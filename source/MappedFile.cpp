@@ -0,0 +1,204 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "../header/MappedFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_HAS_MMAP 1
+#endif
+
+namespace
+{
+    [[noreturn]] void throw_system_error(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path, const Mode mode)
+{
+    open(path, mode);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    swap(*this, other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    MappedFile moved(std::move(other));
+    swap(*this, moved);
+    return *this;
+}
+
+void swap(MappedFile& first, MappedFile& second) noexcept
+{
+    using std::swap;
+    swap(first.descriptor, second.descriptor);
+    swap(first.mapping, second.mapping);
+    swap(first.size, second.size);
+    swap(first.read_only, second.read_only);
+}
+
+#if defined(MAPPED_FILE_HAS_MMAP)
+
+void MappedFile::open(const std::filesystem::path& path, const Mode mode)
+{
+    close();
+
+    int flags = O_RDONLY;
+    if (mode == Mode::ReadWrite) flags = O_RDWR | O_CREAT;
+    if (mode == Mode::Truncate) flags = O_RDWR | O_CREAT | O_TRUNC;
+
+    descriptor = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (descriptor == -1)
+    {
+        throw_system_error("MappedFile: open");
+    }
+    read_only = mode == Mode::ReadOnly;
+
+    struct stat status{};
+    if (::fstat(descriptor, &status) == -1)
+    {
+        const int error = errno;
+        close();
+        errno = error;
+        throw_system_error("MappedFile: fstat");
+    }
+
+    try
+    {
+        map(static_cast<size_t>(status.st_size));
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+}
+
+void MappedFile::close() noexcept
+{
+    unmap();
+    if (descriptor != -1)
+    {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+    read_only = false;
+}
+
+void MappedFile::resize(const size_t new_size)
+{
+    if (new_size == size)
+        return;
+
+    if (::ftruncate(descriptor, static_cast<off_t>(new_size)) == -1)
+    {
+        throw_system_error("MappedFile: ftruncate");
+    }
+
+#if defined(MREMAP_MAYMOVE)
+    if (mapping && new_size)
+    {
+        void* remapped = ::mremap(mapping, size, new_size, MREMAP_MAYMOVE);
+        if (remapped == MAP_FAILED)
+        {
+            throw_system_error("MappedFile: mremap");
+        }
+        mapping = static_cast<std::byte*>(remapped);
+        size = new_size;
+        return;
+    }
+#endif
+
+    unmap();
+    map(new_size);
+}
+
+void MappedFile::sync(const size_t byte_count) const
+{
+    if (!mapping || read_only || byte_count == 0ull)
+        return;
+
+    if (::msync(mapping, std::min(byte_count, size), MS_SYNC) == -1)
+    {
+        throw_system_error("MappedFile: msync");
+    }
+}
+
+void MappedFile::map(const size_t new_size)
+{
+    if (new_size == 0ull)
+    {
+        mapping = nullptr;
+        size = 0ull;
+        return;
+    }
+
+    const int protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* mapped = ::mmap(nullptr, new_size, protection, MAP_SHARED, descriptor, 0);
+    if (mapped == MAP_FAILED)
+    {
+        throw_system_error("MappedFile: mmap");
+    }
+    mapping = static_cast<std::byte*>(mapped);
+    size = new_size;
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (mapping)
+    {
+        ::munmap(mapping, size);
+    }
+    mapping = nullptr;
+    size = 0ull;
+}
+
+#else
+
+void MappedFile::open(const std::filesystem::path&, Mode)
+{
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "MappedFile: no mmap on this platform");
+}
+
+void MappedFile::close() noexcept
+{
+}
+
+void MappedFile::resize(size_t)
+{
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "MappedFile: no mmap on this platform");
+}
+
+void MappedFile::sync(size_t) const
+{
+}
+
+void MappedFile::map(size_t)
+{
+}
+
+void MappedFile::unmap() noexcept
+{
+}
+
+#endif
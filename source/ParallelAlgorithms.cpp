@@ -0,0 +1,97 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "../header/ParallelAlgorithms.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace Parallel::detail
+{
+    ThreadPool& pool_of(const Options& options)
+    {
+        return options.pool ? *options.pool : ThreadPool::get_default();
+    }
+
+    size_t thread_count_of(const Options& options)
+    {
+        const size_t available = pool_of(options).get_thread_count() + 1ull;
+        return options.max_threads ? std::min<size_t>(options.max_threads, available) : available;
+    }
+
+    void run_chunks(const ChunkLayout& layout, const size_t thread_count, ThreadPool& pool,
+                    const std::function<void(size_t, size_t)>& body)
+    {
+        const size_t chunk_count = layout.chunk_count();
+        if (chunk_count == 0ull)
+            return;
+
+        const size_t helper_count = std::min<size_t>(thread_count, chunk_count) - 1ull;
+        if (helper_count == 0ull)
+        {
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+            {
+                const auto [begin, end] = layout.bounds(chunk);
+                body(begin, end);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next_chunk{0ull};
+        std::atomic<size_t> running_helpers{helper_count};
+        std::exception_ptr first_exception;
+        std::mutex exception_mutex;
+
+        auto work = [&]
+        {
+            size_t chunk;
+            while ((chunk = next_chunk.fetch_add(1ull, std::memory_order_relaxed)) < chunk_count)
+            {
+                try
+                {
+                    const auto [begin, end] = layout.bounds(chunk);
+                    body(begin, end);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(exception_mutex);
+                    if (!first_exception)
+                    {
+                        first_exception = std::current_exception();
+                    }
+                    next_chunk.store(chunk_count, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        for (size_t i = 0; i < helper_count; ++i)
+        {
+            pool.submit([&]
+            {
+                work();
+                running_helpers.fetch_sub(1ull, std::memory_order_release);
+            });
+        }
+
+        work();
+
+        // The helpers reference this stack frame: wait for every one of them, running pending
+        // pool tasks meanwhile so a helper still queued behind us can't deadlock the call.
+        while (running_helpers.load(std::memory_order_acquire) != 0ull)
+        {
+            if (!pool.try_run_pending_task())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        if (first_exception)
+        {
+            std::rethrow_exception(first_exception);
+        }
+    }
+}
@@ -0,0 +1,132 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "../header/ThreadPool.h"
+
+#include <algorithm>
+
+thread_local ThreadPool* ThreadPool::current_pool = nullptr;
+thread_local size_t ThreadPool::current_queue = 0ull;
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    thread_count = std::max<size_t>(thread_count, 1ull);
+
+    queues.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(sleep_mutex);
+        is_stopping = true;
+    }
+    wake_up.notify_all();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    const size_t index = current_pool == this
+        ? current_queue
+        : next_queue.fetch_add(1ull, std::memory_order_relaxed) % queues.size();
+
+    // Counted before being queued so a concurrent pop can never make the counter wrap.
+    pending_tasks.fetch_add(1ull, std::memory_order_release);
+    {
+        std::lock_guard lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock orders the increment with a worker checking its wait predicate.
+    {
+        std::lock_guard lock(sleep_mutex);
+    }
+    wake_up.notify_one();
+}
+
+bool ThreadPool::pop_task(const size_t preferred_queue, Task& task)
+{
+    {
+        auto& own = *queues[preferred_queue];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending_tasks.fetch_sub(1ull, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        auto& victim = *queues[(preferred_queue + offset) % queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending_tasks.fetch_sub(1ull, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::try_run_pending_task()
+{
+    if (pending_tasks.load(std::memory_order_acquire) == 0ull)
+        return false;
+
+    Task task;
+    const size_t preferred_queue = current_pool == this ? current_queue : 0ull;
+    if (!pop_task(preferred_queue, task))
+        return false;
+
+    task();
+    return true;
+}
+
+void ThreadPool::worker_loop(const size_t index)
+{
+    current_pool = this;
+    current_queue = index;
+
+    while (true)
+    {
+        Task task;
+        if (pop_task(index, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock lock(sleep_mutex);
+        wake_up.wait(lock, [this] { return is_stopping || pending_tasks.load(std::memory_order_acquire) > 0ull; });
+        if (is_stopping && pending_tasks.load(std::memory_order_acquire) == 0ull)
+            return;
+    }
+}
+
+ThreadPool& ThreadPool::get_default()
+{
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,188 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "../header/VectorAlgorithms.h"
+
+#include <atomic>
+
+#include "VectorAlgorithmsKernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace VectorAlgorithms
+{
+    namespace
+    {
+        InstructionSet detect_cpu_instruction_set() noexcept
+        {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return InstructionSet::AVX512;
+            if (__builtin_cpu_supports("avx2")) return InstructionSet::AVX2;
+            if (__builtin_cpu_supports("sse2")) return InstructionSet::SSE2;
+            return InstructionSet::Scalar;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int registers[4];
+            __cpuid(registers, 0);
+            const int highest_leaf = registers[0];
+
+            __cpuid(registers, 1);
+            const bool has_sse2 = registers[3] & (1 << 26);
+            const bool has_os_saved_avx = (registers[2] & (1 << 27)) && (registers[2] & (1 << 28));
+            if (!has_sse2) return InstructionSet::Scalar;
+            if (!has_os_saved_avx || highest_leaf < 7) return InstructionSet::SSE2;
+
+            // The OS must save the YMM (and for AVX-512 the ZMM and mask) registers on context switches.
+            const unsigned long long enabled_states = _xgetbv(0);
+            if ((enabled_states & 0x6) != 0x6) return InstructionSet::SSE2;
+
+            __cpuidex(registers, 7, 0);
+            if ((registers[1] & (1 << 16)) && (enabled_states & 0xe6) == 0xe6) return InstructionSet::AVX512;
+            if (registers[1] & (1 << 5)) return InstructionSet::AVX2;
+            return InstructionSet::SSE2;
+#else
+            return InstructionSet::Scalar;
+#endif
+        }
+
+        template<typename T>
+        const detail::KernelTable<T>* kernels_for(const InstructionSet instruction_set) noexcept
+        {
+            switch (instruction_set)
+            {
+            case InstructionSet::AVX512: return detail::avx512_kernels<T>();
+            case InstructionSet::AVX2: return detail::avx2_kernels<T>();
+            case InstructionSet::SSE2: return detail::sse2_kernels<T>();
+            default: return nullptr;
+            }
+        }
+
+        std::atomic<InstructionSet>& active_instruction_set_storage() noexcept
+        {
+            static std::atomic<InstructionSet> instruction_set{detected_instruction_set()};
+            return instruction_set;
+        }
+
+        // nullptr means the scalar kernels.
+        template<typename T>
+        const detail::KernelTable<T>* active_kernels() noexcept
+        {
+            return kernels_for<T>(active_instruction_set_storage().load(std::memory_order_relaxed));
+        }
+    }
+
+    InstructionSet detected_instruction_set() noexcept
+    {
+        static const InstructionSet instruction_set = []
+        {
+            // A CPU feature is only usable if this build compiled the matching kernels.
+            InstructionSet candidate = detect_cpu_instruction_set();
+            while (candidate != InstructionSet::Scalar && !kernels_for<float>(candidate))
+            {
+                candidate = static_cast<InstructionSet>(static_cast<int>(candidate) - 1);
+            }
+            return candidate;
+        }();
+        return instruction_set;
+    }
+
+    InstructionSet active_instruction_set() noexcept
+    {
+        return active_instruction_set_storage().load(std::memory_order_relaxed);
+    }
+
+    InstructionSet set_instruction_set(InstructionSet instruction_set) noexcept
+    {
+        if (static_cast<int>(instruction_set) > static_cast<int>(detected_instruction_set()))
+        {
+            instruction_set = detected_instruction_set();
+        }
+        active_instruction_set_storage().store(instruction_set, std::memory_order_relaxed);
+        return instruction_set;
+    }
+
+    const char* to_string(const InstructionSet instruction_set) noexcept
+    {
+        switch (instruction_set)
+        {
+        case InstructionSet::SSE2: return "SSE2";
+        case InstructionSet::AVX2: return "AVX2";
+        case InstructionSet::AVX512: return "AVX-512";
+        default: return "Scalar";
+        }
+    }
+
+    namespace detail
+    {
+        template<SimdElement T>
+        size_t find(const T* data, const size_t length, const T value) noexcept
+        {
+            if (const auto* kernels = active_kernels<T>())
+                return kernels->find(data, length, value);
+            return scalar::find(data, length, value);
+        }
+
+        template<SimdElement T>
+        size_t count(const T* data, const size_t length, const T value) noexcept
+        {
+            if (const auto* kernels = active_kernels<T>())
+                return kernels->count(data, length, value);
+            return scalar::count(data, length, value);
+        }
+
+        template<SimdElement T>
+        std::pair<T, T> minmax(const T* data, const size_t length) noexcept
+        {
+            if (const auto* kernels = active_kernels<T>())
+            {
+                std::pair<T, T> result;
+                kernels->minmax(data, length, result.first, result.second);
+                return result;
+            }
+            return scalar::minmax(data, length);
+        }
+
+        template<SimdElement T>
+        SumType<T> sum(const T* data, const size_t length) noexcept
+        {
+            if (const auto* kernels = active_kernels<T>())
+                return kernels->sum(data, length);
+            return scalar::sum(data, length);
+        }
+
+        template<SimdElement T>
+        SumType<T> dot(const T* first, const T* second, const size_t length) noexcept
+        {
+            if (const auto* kernels = active_kernels<T>())
+                return kernels->dot(first, second, length);
+            return scalar::dot(first, second, length);
+        }
+
+        template<SimdElement T>
+        void fill(T* data, const size_t length, const T value) noexcept
+        {
+            if (const auto* kernels = active_kernels<T>())
+                kernels->fill(data, length, value);
+            else
+                scalar::fill(data, length, value);
+        }
+
+#define VECTOR_ALGORITHMS_INSTANTIATE(T) \
+        template size_t find<T>(const T*, size_t, T) noexcept; \
+        template size_t count<T>(const T*, size_t, T) noexcept; \
+        template std::pair<T, T> minmax<T>(const T*, size_t) noexcept; \
+        template SumType<T> sum<T>(const T*, size_t) noexcept; \
+        template SumType<T> dot<T>(const T*, const T*, size_t) noexcept; \
+        template void fill<T>(T*, size_t, T) noexcept;
+
+        VECTOR_ALGORITHMS_INSTANTIATE(float)
+        VECTOR_ALGORITHMS_INSTANTIATE(double)
+        VECTOR_ALGORITHMS_INSTANTIATE(int32_t)
+
+#undef VECTOR_ALGORITHMS_INSTANTIATE
+    }
+}
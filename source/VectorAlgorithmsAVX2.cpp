@@ -0,0 +1,123 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "VectorAlgorithmsKernels.h"
+
+// Built with the AVX2 target flags set in CMakeLists.txt, only ever called after a runtime check.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace VectorAlgorithms::detail
+{
+#if defined(__AVX2__)
+    namespace avx2
+    {
+        template<typename T>
+        struct Ops;
+
+        template<>
+        struct Ops<float>
+        {
+            using Register = __m256;
+            using Accumulator = __m256;
+            static constexpr size_t width = 8ull;
+
+            static Register load(const float* data) { return _mm256_loadu_ps(data); }
+            static void store(float* data, const Register value) { _mm256_storeu_ps(data, value); }
+            static Register broadcast(const float value) { return _mm256_set1_ps(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+            static Register min(const Register a, const Register b) { return _mm256_min_ps(a, b); }
+            static Register max(const Register a, const Register b) { return _mm256_max_ps(a, b); }
+
+            static Accumulator zero() { return _mm256_setzero_ps(); }
+            static Accumulator accumulate(const Accumulator sum, const Register value) { return _mm256_add_ps(sum, value); }
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b) { return _mm256_add_ps(sum, _mm256_mul_ps(a, b)); }
+
+            static float reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, float>(sum); }
+            static float reduce_min(const Register value) { return reduce_lanes<Reduction::Min, float>(value); }
+            static float reduce_max(const Register value) { return reduce_lanes<Reduction::Max, float>(value); }
+        };
+
+        template<>
+        struct Ops<double>
+        {
+            using Register = __m256d;
+            using Accumulator = __m256d;
+            static constexpr size_t width = 4ull;
+
+            static Register load(const double* data) { return _mm256_loadu_pd(data); }
+            static void store(double* data, const Register value) { _mm256_storeu_pd(data, value); }
+            static Register broadcast(const double value) { return _mm256_set1_pd(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+            static Register min(const Register a, const Register b) { return _mm256_min_pd(a, b); }
+            static Register max(const Register a, const Register b) { return _mm256_max_pd(a, b); }
+
+            static Accumulator zero() { return _mm256_setzero_pd(); }
+            static Accumulator accumulate(const Accumulator sum, const Register value) { return _mm256_add_pd(sum, value); }
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b) { return _mm256_add_pd(sum, _mm256_mul_pd(a, b)); }
+
+            static double reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, double>(sum); }
+            static double reduce_min(const Register value) { return reduce_lanes<Reduction::Min, double>(value); }
+            static double reduce_max(const Register value) { return reduce_lanes<Reduction::Max, double>(value); }
+        };
+
+        template<>
+        struct Ops<int32_t>
+        {
+            using Register = __m256i;
+            // Four int64 lanes, the int32 lanes are sign extended before being added.
+            using Accumulator = __m256i;
+            static constexpr size_t width = 8ull;
+
+            static Register load(const int32_t* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+            static void store(int32_t* data, const Register value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value); }
+            static Register broadcast(const int32_t value) { return _mm256_set1_epi32(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+            static Register min(const Register a, const Register b) { return _mm256_min_epi32(a, b); }
+            static Register max(const Register a, const Register b) { return _mm256_max_epi32(a, b); }
+
+            static __m256i widen_low(const Register value) { return _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)); }
+            static __m256i widen_high(const Register value) { return _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)); }
+
+            static Accumulator zero() { return _mm256_setzero_si256(); }
+
+            static Accumulator accumulate(const Accumulator sum, const Register value)
+            {
+                return _mm256_add_epi64(sum, _mm256_add_epi64(widen_low(value), widen_high(value)));
+            }
+
+            // _mm256_mul_epi32 multiplies the sign extended low halves of each 64 bit lane.
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b)
+            {
+                const __m256i low = _mm256_mul_epi32(widen_low(a), widen_low(b));
+                const __m256i high = _mm256_mul_epi32(widen_high(a), widen_high(b));
+                return _mm256_add_epi64(sum, _mm256_add_epi64(low, high));
+            }
+
+            static int64_t reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, int64_t>(sum); }
+            static int32_t reduce_min(const Register value) { return reduce_lanes<Reduction::Min, int32_t>(value); }
+            static int32_t reduce_max(const Register value) { return reduce_lanes<Reduction::Max, int32_t>(value); }
+        };
+    }
+
+    template<typename T>
+    const KernelTable<T>* avx2_kernels() noexcept
+    {
+        static constexpr KernelTable<T> table = make_kernel_table<avx2::Ops, T>();
+        return &table;
+    }
+#else
+    template<typename T>
+    const KernelTable<T>* avx2_kernels() noexcept
+    {
+        return nullptr;
+    }
+#endif
+
+    template const KernelTable<float>* avx2_kernels<float>() noexcept;
+    template const KernelTable<double>* avx2_kernels<double>() noexcept;
+    template const KernelTable<int32_t>* avx2_kernels<int32_t>() noexcept;
+}
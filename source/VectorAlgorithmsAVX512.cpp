@@ -0,0 +1,123 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "VectorAlgorithmsKernels.h"
+
+// Built with the AVX-512F target flags set in CMakeLists.txt, only ever called after a runtime check.
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace VectorAlgorithms::detail
+{
+#if defined(__AVX512F__)
+    namespace avx512
+    {
+        template<typename T>
+        struct Ops;
+
+        template<>
+        struct Ops<float>
+        {
+            using Register = __m512;
+            using Accumulator = __m512;
+            static constexpr size_t width = 16ull;
+
+            static Register load(const float* data) { return _mm512_loadu_ps(data); }
+            static void store(float* data, const Register value) { _mm512_storeu_ps(data, value); }
+            static Register broadcast(const float value) { return _mm512_set1_ps(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ)); }
+            static Register min(const Register a, const Register b) { return _mm512_min_ps(a, b); }
+            static Register max(const Register a, const Register b) { return _mm512_max_ps(a, b); }
+
+            static Accumulator zero() { return _mm512_setzero_ps(); }
+            static Accumulator accumulate(const Accumulator sum, const Register value) { return _mm512_add_ps(sum, value); }
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b) { return _mm512_add_ps(sum, _mm512_mul_ps(a, b)); }
+
+            static float reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, float>(sum); }
+            static float reduce_min(const Register value) { return reduce_lanes<Reduction::Min, float>(value); }
+            static float reduce_max(const Register value) { return reduce_lanes<Reduction::Max, float>(value); }
+        };
+
+        template<>
+        struct Ops<double>
+        {
+            using Register = __m512d;
+            using Accumulator = __m512d;
+            static constexpr size_t width = 8ull;
+
+            static Register load(const double* data) { return _mm512_loadu_pd(data); }
+            static void store(double* data, const Register value) { _mm512_storeu_pd(data, value); }
+            static Register broadcast(const double value) { return _mm512_set1_pd(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ)); }
+            static Register min(const Register a, const Register b) { return _mm512_min_pd(a, b); }
+            static Register max(const Register a, const Register b) { return _mm512_max_pd(a, b); }
+
+            static Accumulator zero() { return _mm512_setzero_pd(); }
+            static Accumulator accumulate(const Accumulator sum, const Register value) { return _mm512_add_pd(sum, value); }
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b) { return _mm512_add_pd(sum, _mm512_mul_pd(a, b)); }
+
+            static double reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, double>(sum); }
+            static double reduce_min(const Register value) { return reduce_lanes<Reduction::Min, double>(value); }
+            static double reduce_max(const Register value) { return reduce_lanes<Reduction::Max, double>(value); }
+        };
+
+        template<>
+        struct Ops<int32_t>
+        {
+            using Register = __m512i;
+            // Eight int64 lanes, the int32 lanes are sign extended before being added.
+            using Accumulator = __m512i;
+            static constexpr size_t width = 16ull;
+
+            static Register load(const int32_t* data) { return _mm512_loadu_si512(data); }
+            static void store(int32_t* data, const Register value) { _mm512_storeu_si512(data, value); }
+            static Register broadcast(const int32_t value) { return _mm512_set1_epi32(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm512_cmpeq_epi32_mask(a, b)); }
+            static Register min(const Register a, const Register b) { return _mm512_min_epi32(a, b); }
+            static Register max(const Register a, const Register b) { return _mm512_max_epi32(a, b); }
+
+            static __m512i widen_low(const Register value) { return _mm512_cvtepi32_epi64(_mm512_castsi512_si256(value)); }
+            static __m512i widen_high(const Register value) { return _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(value, 1)); }
+
+            static Accumulator zero() { return _mm512_setzero_si512(); }
+
+            static Accumulator accumulate(const Accumulator sum, const Register value)
+            {
+                return _mm512_add_epi64(sum, _mm512_add_epi64(widen_low(value), widen_high(value)));
+            }
+
+            // _mm512_mul_epi32 multiplies the sign extended low halves of each 64 bit lane.
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b)
+            {
+                const __m512i low = _mm512_mul_epi32(widen_low(a), widen_low(b));
+                const __m512i high = _mm512_mul_epi32(widen_high(a), widen_high(b));
+                return _mm512_add_epi64(sum, _mm512_add_epi64(low, high));
+            }
+
+            static int64_t reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, int64_t>(sum); }
+            static int32_t reduce_min(const Register value) { return reduce_lanes<Reduction::Min, int32_t>(value); }
+            static int32_t reduce_max(const Register value) { return reduce_lanes<Reduction::Max, int32_t>(value); }
+        };
+    }
+
+    template<typename T>
+    const KernelTable<T>* avx512_kernels() noexcept
+    {
+        static constexpr KernelTable<T> table = make_kernel_table<avx512::Ops, T>();
+        return &table;
+    }
+#else
+    template<typename T>
+    const KernelTable<T>* avx512_kernels() noexcept
+    {
+        return nullptr;
+    }
+#endif
+
+    template const KernelTable<float>* avx512_kernels<float>() noexcept;
+    template const KernelTable<double>* avx512_kernels<double>() noexcept;
+    template const KernelTable<int32_t>* avx512_kernels<int32_t>() noexcept;
+}
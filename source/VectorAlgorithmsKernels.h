@@ -0,0 +1,261 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../header/VectorAlgorithms.h"
+
+// Shared between the per instruction set translation units. Each of them is compiled with its own
+// target flags and instantiates these kernels with its own Ops, so no code compiled for a wide
+// instruction set can be picked by the linker for a caller running on a narrower CPU.
+//
+// An Ops<T> provides:
+//   width, Register, Accumulator,
+//   load, store, broadcast, equal_mask (one bit per lane), min, max,
+//   zero, accumulate (sum of a register), accumulate_product, reduce_sum, reduce_min, reduce_max.
+// The reductions usually forward to reduce_lanes, they only run once per kernel call.
+namespace VectorAlgorithms::detail
+{
+    template<typename T>
+    struct KernelTable
+    {
+        size_t (*find)(const T*, size_t, T);
+        size_t (*count)(const T*, size_t, T);
+        void (*minmax)(const T*, size_t, T&, T&);
+        SumType<T> (*sum)(const T*, size_t);
+        SumType<T> (*dot)(const T*, const T*, size_t);
+        void (*fill)(T*, size_t, T);
+    };
+
+    // Each returns nullptr when the build can't target that instruction set.
+    template<typename T> const KernelTable<T>* sse2_kernels() noexcept;
+    template<typename T> const KernelTable<T>* avx2_kernels() noexcept;
+    template<typename T> const KernelTable<T>* avx512_kernels() noexcept;
+
+    namespace
+    {
+        constexpr size_t unroll = 4ull;
+
+        enum class Reduction { Sum, Min, Max };
+
+        template<Reduction Operation, typename T, typename Register>
+        T reduce_lanes(const Register& value)
+        {
+            constexpr size_t lane_count = sizeof(Register) / sizeof(T);
+            T lanes[lane_count];
+            std::memcpy(lanes, &value, sizeof(Register));
+
+            T result = lanes[0];
+            for (size_t i = 1ull; i < lane_count; ++i)
+            {
+                if constexpr (Operation == Reduction::Min)
+                    result = lanes[i] < result ? lanes[i] : result;
+                else if constexpr (Operation == Reduction::Max)
+                    result = lanes[i] > result ? lanes[i] : result;
+                else
+                    result += lanes[i];
+            }
+            return result;
+        }
+
+        inline size_t lowest_set_bit(uint64_t mask) noexcept
+        {
+#if defined(__GNUC__)
+            return static_cast<size_t>(__builtin_ctzll(mask));
+#else
+            size_t index = 0ull;
+            while (!(mask & 1ull))
+            {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        inline size_t set_bit_count(uint64_t mask) noexcept
+        {
+#if defined(__GNUC__)
+            return static_cast<size_t>(__builtin_popcountll(mask));
+#else
+            size_t result = 0ull;
+            while (mask)
+            {
+                mask &= mask - 1ull;
+                ++result;
+            }
+            return result;
+#endif
+        }
+
+        template<typename Ops, typename T>
+        size_t find_kernel(const T* data, const size_t length, const T value)
+        {
+            const auto needle = Ops::broadcast(value);
+            size_t i = 0ull;
+            for (; i + Ops::width <= length; i += Ops::width)
+            {
+                if (const uint64_t mask = Ops::equal_mask(Ops::load(data + i), needle))
+                {
+                    return i + lowest_set_bit(mask);
+                }
+            }
+            for (; i < length; ++i)
+            {
+                if (data[i] == value)
+                {
+                    return i;
+                }
+            }
+            return length;
+        }
+
+        template<typename Ops, typename T>
+        size_t count_kernel(const T* data, const size_t length, const T value)
+        {
+            const auto needle = Ops::broadcast(value);
+            size_t result = 0ull;
+            size_t i = 0ull;
+            for (; i + Ops::width <= length; i += Ops::width)
+            {
+                result += set_bit_count(Ops::equal_mask(Ops::load(data + i), needle));
+            }
+            for (; i < length; ++i)
+            {
+                result += data[i] == value;
+            }
+            return result;
+        }
+
+        template<typename Ops, typename T>
+        void minmax_kernel(const T* data, const size_t length, T& minimum, T& maximum)
+        {
+            size_t i = 0ull;
+            minimum = data[0];
+            maximum = data[0];
+
+            if (length >= Ops::width)
+            {
+                auto minimums = Ops::load(data);
+                auto maximums = minimums;
+                for (i = Ops::width; i + Ops::width <= length; i += Ops::width)
+                {
+                    const auto values = Ops::load(data + i);
+                    minimums = Ops::min(values, minimums);
+                    maximums = Ops::max(values, maximums);
+                }
+                minimum = Ops::reduce_min(minimums);
+                maximum = Ops::reduce_max(maximums);
+            }
+
+            for (; i < length; ++i)
+            {
+                minimum = data[i] < minimum ? data[i] : minimum;
+                maximum = data[i] > maximum ? data[i] : maximum;
+            }
+        }
+
+        // Several independent accumulators hide the latency of the vector additions.
+        template<typename Ops, typename T>
+        SumType<T> sum_kernel(const T* data, const size_t length)
+        {
+            typename Ops::Accumulator accumulators[unroll];
+            for (auto& accumulator : accumulators)
+            {
+                accumulator = Ops::zero();
+            }
+
+            size_t i = 0ull;
+            for (; i + unroll * Ops::width <= length; i += unroll * Ops::width)
+            {
+                for (size_t lane = 0ull; lane < unroll; ++lane)
+                {
+                    accumulators[lane] = Ops::accumulate(accumulators[lane], Ops::load(data + i + lane * Ops::width));
+                }
+            }
+            for (; i + Ops::width <= length; i += Ops::width)
+            {
+                accumulators[0] = Ops::accumulate(accumulators[0], Ops::load(data + i));
+            }
+
+            SumType<T> result = Ops::reduce_sum(accumulators[0]);
+            for (size_t lane = 1ull; lane < unroll; ++lane)
+            {
+                result += Ops::reduce_sum(accumulators[lane]);
+            }
+            for (; i < length; ++i)
+            {
+                result += static_cast<SumType<T>>(data[i]);
+            }
+            return result;
+        }
+
+        template<typename Ops, typename T>
+        SumType<T> dot_kernel(const T* first, const T* second, const size_t length)
+        {
+            typename Ops::Accumulator accumulators[unroll];
+            for (auto& accumulator : accumulators)
+            {
+                accumulator = Ops::zero();
+            }
+
+            size_t i = 0ull;
+            for (; i + unroll * Ops::width <= length; i += unroll * Ops::width)
+            {
+                for (size_t lane = 0ull; lane < unroll; ++lane)
+                {
+                    const size_t offset = i + lane * Ops::width;
+                    accumulators[lane] = Ops::accumulate_product(accumulators[lane], Ops::load(first + offset), Ops::load(second + offset));
+                }
+            }
+            for (; i + Ops::width <= length; i += Ops::width)
+            {
+                accumulators[0] = Ops::accumulate_product(accumulators[0], Ops::load(first + i), Ops::load(second + i));
+            }
+
+            SumType<T> result = Ops::reduce_sum(accumulators[0]);
+            for (size_t lane = 1ull; lane < unroll; ++lane)
+            {
+                result += Ops::reduce_sum(accumulators[lane]);
+            }
+            for (; i < length; ++i)
+            {
+                result += static_cast<SumType<T>>(first[i]) * static_cast<SumType<T>>(second[i]);
+            }
+            return result;
+        }
+
+        template<typename Ops, typename T>
+        void fill_kernel(T* data, const size_t length, const T value)
+        {
+            const auto filler = Ops::broadcast(value);
+            size_t i = 0ull;
+            for (; i + Ops::width <= length; i += Ops::width)
+            {
+                Ops::store(data + i, filler);
+            }
+            for (; i < length; ++i)
+            {
+                data[i] = value;
+            }
+        }
+
+        template<template<typename> class Ops, typename T>
+        constexpr KernelTable<T> make_kernel_table() noexcept
+        {
+            return KernelTable<T>{
+                &find_kernel<Ops<T>, T>,
+                &count_kernel<Ops<T>, T>,
+                &minmax_kernel<Ops<T>, T>,
+                &sum_kernel<Ops<T>, T>,
+                &dot_kernel<Ops<T>, T>,
+                &fill_kernel<Ops<T>, T>
+            };
+        }
+    }
+}
@@ -0,0 +1,138 @@
+﻿//
+// Created by y.grallan on 16/10/2026.
+// Copyright (c) 2026 Yann Grallan All rights reserved.
+//
+
+#include "VectorAlgorithmsKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTOR_ALGORITHMS_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace VectorAlgorithms::detail
+{
+#if defined(VECTOR_ALGORITHMS_HAS_SSE2)
+    namespace sse2
+    {
+        template<typename T>
+        struct Ops;
+
+        template<>
+        struct Ops<float>
+        {
+            using Register = __m128;
+            using Accumulator = __m128;
+            static constexpr size_t width = 4ull;
+
+            static Register load(const float* data) { return _mm_loadu_ps(data); }
+            static void store(float* data, const Register value) { _mm_storeu_ps(data, value); }
+            static Register broadcast(const float value) { return _mm_set1_ps(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+            static Register min(const Register a, const Register b) { return _mm_min_ps(a, b); }
+            static Register max(const Register a, const Register b) { return _mm_max_ps(a, b); }
+
+            static Accumulator zero() { return _mm_setzero_ps(); }
+            static Accumulator accumulate(const Accumulator sum, const Register value) { return _mm_add_ps(sum, value); }
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b) { return _mm_add_ps(sum, _mm_mul_ps(a, b)); }
+
+            static float reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, float>(sum); }
+            static float reduce_min(const Register value) { return reduce_lanes<Reduction::Min, float>(value); }
+            static float reduce_max(const Register value) { return reduce_lanes<Reduction::Max, float>(value); }
+        };
+
+        template<>
+        struct Ops<double>
+        {
+            using Register = __m128d;
+            using Accumulator = __m128d;
+            static constexpr size_t width = 2ull;
+
+            static Register load(const double* data) { return _mm_loadu_pd(data); }
+            static void store(double* data, const Register value) { _mm_storeu_pd(data, value); }
+            static Register broadcast(const double value) { return _mm_set1_pd(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+            static Register min(const Register a, const Register b) { return _mm_min_pd(a, b); }
+            static Register max(const Register a, const Register b) { return _mm_max_pd(a, b); }
+
+            static Accumulator zero() { return _mm_setzero_pd(); }
+            static Accumulator accumulate(const Accumulator sum, const Register value) { return _mm_add_pd(sum, value); }
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b) { return _mm_add_pd(sum, _mm_mul_pd(a, b)); }
+
+            static double reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, double>(sum); }
+            static double reduce_min(const Register value) { return reduce_lanes<Reduction::Min, double>(value); }
+            static double reduce_max(const Register value) { return reduce_lanes<Reduction::Max, double>(value); }
+        };
+
+        template<>
+        struct Ops<int32_t>
+        {
+            using Register = __m128i;
+            // Two int64 lanes, the int32 lanes are sign extended before being added.
+            using Accumulator = __m128i;
+            static constexpr size_t width = 4ull;
+
+            static Register load(const int32_t* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+            static void store(int32_t* data, const Register value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value); }
+            static Register broadcast(const int32_t value) { return _mm_set1_epi32(value); }
+            static uint64_t equal_mask(const Register a, const Register b) { return static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+
+            // SSE2 has no 32 bit min/max, select through a comparison mask.
+            static Register min(const Register a, const Register b)
+            {
+                const __m128i a_is_greater = _mm_cmpgt_epi32(a, b);
+                return _mm_or_si128(_mm_and_si128(a_is_greater, b), _mm_andnot_si128(a_is_greater, a));
+            }
+
+            static Register max(const Register a, const Register b)
+            {
+                const __m128i a_is_greater = _mm_cmpgt_epi32(a, b);
+                return _mm_or_si128(_mm_and_si128(a_is_greater, a), _mm_andnot_si128(a_is_greater, b));
+            }
+
+            static Accumulator zero() { return _mm_setzero_si128(); }
+
+            static Accumulator accumulate(const Accumulator sum, const Register value)
+            {
+                const __m128i sign = _mm_srai_epi32(value, 31);
+                const __m128i low = _mm_unpacklo_epi32(value, sign);
+                const __m128i high = _mm_unpackhi_epi32(value, sign);
+                return _mm_add_epi64(sum, _mm_add_epi64(low, high));
+            }
+
+            // SSE2 has no signed 32x32->64 multiply, the products are computed lane by lane.
+            static Accumulator accumulate_product(const Accumulator sum, const Register a, const Register b)
+            {
+                alignas(16) int32_t a_lanes[width];
+                alignas(16) int32_t b_lanes[width];
+                _mm_store_si128(reinterpret_cast<__m128i*>(a_lanes), a);
+                _mm_store_si128(reinterpret_cast<__m128i*>(b_lanes), b);
+                const int64_t low = static_cast<int64_t>(a_lanes[0]) * b_lanes[0] + static_cast<int64_t>(a_lanes[1]) * b_lanes[1];
+                const int64_t high = static_cast<int64_t>(a_lanes[2]) * b_lanes[2] + static_cast<int64_t>(a_lanes[3]) * b_lanes[3];
+                return _mm_add_epi64(sum, _mm_set_epi64x(high, low));
+            }
+
+            static int64_t reduce_sum(const Accumulator sum) { return reduce_lanes<Reduction::Sum, int64_t>(sum); }
+            static int32_t reduce_min(const Register value) { return reduce_lanes<Reduction::Min, int32_t>(value); }
+            static int32_t reduce_max(const Register value) { return reduce_lanes<Reduction::Max, int32_t>(value); }
+        };
+    }
+
+    template<typename T>
+    const KernelTable<T>* sse2_kernels() noexcept
+    {
+        static constexpr KernelTable<T> table = make_kernel_table<sse2::Ops, T>();
+        return &table;
+    }
+#else
+    template<typename T>
+    const KernelTable<T>* sse2_kernels() noexcept
+    {
+        return nullptr;
+    }
+#endif
+
+    template const KernelTable<float>* sse2_kernels<float>() noexcept;
+    template const KernelTable<double>* sse2_kernels<double>() noexcept;
+    template const KernelTable<int32_t>* sse2_kernels<int32_t>() noexcept;
+}